@@ -0,0 +1,432 @@
+#define _POSIX_C_SOURCE 200809L // For clock_gettime, getopt
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h> // For memset, strcmp, strtok
+#include <time.h>
+#include <unistd.h> // For getopt
+#include "linkedlist.h"
+
+
+// Nodes a single O(n) operation may walk in total per (size, payload) pair; calls are capped to fit.
+#define BENCH_WALK_BUDGET ((size_t)20 * 1000 * 1000)
+#define BENCH_MAX_WALK_CALLS ((size_t)1000)
+#define BENCH_CREATE_CALLS ((size_t)100000)
+#define BENCH_MAX_PAYLOAD ((size_t)4096)
+
+// Calls are timed in batches, since a call on a short list is shorter than the clock's resolution:
+// O(1) operations BENCH_BATCH calls at a time, O(n) ones enough calls to walk about BENCH_BATCH_NODES.
+#define BENCH_BATCH ((size_t)256)
+#define BENCH_BATCH_NODES ((size_t)4096)
+
+
+static const size_t bench_payloads[] = { 4, 16, 64, 256, 1024, 4096 };
+
+
+static sllist* bench_create_aligned64(size_t data_size) {
+    return sllist_create_aligned(data_size, 64);
+}
+
+
+/**
+ * @brief A kind of list to benchmark: how it is created, and the payload alignment it uses.
+ */
+struct bench_variant {
+    const char* name;
+    sllist* (*create)(size_t data_size);
+    size_t alignment;
+};
+
+
+static const struct bench_variant bench_variants[] = {
+    { "heap", sllist_create, 0 },
+    { "arena", sllist_create_arena, 0 },
+    { "aligned64", bench_create_aligned64, 64 },
+};
+#define BENCH_VARIANT_COUNT (sizeof(bench_variants) / sizeof(bench_variants[0]))
+
+
+/**
+ * @brief State shared by the benchmarked operations.
+ */
+struct bench_ctx {
+    const struct bench_variant* variant;
+    sllist* list;
+    size_t data_size;
+    const size_t* indices; // Pre-drawn random indices, one per call
+    unsigned char payload[BENCH_MAX_PAYLOAD];
+    volatile size_t sink; // Keeps results of read-only operations alive
+};
+
+
+/**
+ * @brief Timings of one operation: total time, and the mean per-call time of every batch.
+ */
+struct bench_stat {
+    uint64_t total_ns;
+    size_t calls;
+    size_t batch;
+    double* samples;
+    size_t count;
+    size_t capacity;
+};
+
+
+/**
+ * @brief Returns a monotonic timestamp in nanoseconds.
+ */
+static uint64_t bench_now_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000u + (uint64_t)ts.tv_nsec;
+}
+
+
+/**
+ * @brief Returns the next value of a xorshift64* generator, so every run sees the same indices for a seed.
+ */
+static uint64_t bench_rand(uint64_t* state) {
+    *state ^= *state >> 12;
+    *state ^= *state << 25;
+    *state ^= *state >> 27;
+    return *state * 0x2545F4914F6CDD1Dull;
+}
+
+
+/**
+ * @brief Returns the number of calls of an O(n) operation to time together on a list of `size` elements.
+ */
+static size_t bench_walk_batch(size_t size) {
+    size_t batch = BENCH_BATCH_NODES / size;
+    return batch < 1 ? 1 : batch > BENCH_BATCH ? BENCH_BATCH : batch;
+}
+
+
+/**
+ * @brief Calls `op` `calls` times in batches of `batch`, adding the timings to `stat`.
+ */
+static void bench_run(struct bench_stat* stat, void (*op)(struct bench_ctx*, size_t), struct bench_ctx* ctx,
+                      size_t calls, size_t batch) {
+    stat->batch = batch;
+    for (size_t i = 0; i < calls; i += batch) {
+        size_t end = i + batch < calls ? i + batch : calls;
+        uint64_t start = bench_now_ns();
+        for (size_t j = i; j < end; j++) {
+            op(ctx, j);
+        }
+        uint64_t elapsed = bench_now_ns() - start;
+
+        if (stat->count == stat->capacity) {
+            size_t capacity = stat->capacity ? stat->capacity * 2 : 64;
+            double* samples = (double*)realloc(stat->samples, capacity * sizeof(double));
+            if (!samples) {
+                fprintf(stderr, "bench: out of memory\n");
+                exit(1);
+            }
+            stat->samples = samples;
+            stat->capacity = capacity;
+        }
+        stat->samples[stat->count++] = (double)elapsed / (double)(end - i);
+        stat->total_ns += elapsed;
+        stat->calls += end - i;
+    }
+}
+
+
+/**
+ * @brief qsort() comparator for doubles.
+ */
+static int bench_compare_double(const void* a, const void* b) {
+    double x = *(const double*)a;
+    double y = *(const double*)b;
+    return (x > y) - (x < y);
+}
+
+
+/**
+ * @brief Prints one CSV row for `stat`, measured on lists like `ctx`'s, and resets it.
+ *
+ * The percentiles are taken over batch means, not single calls: a batch of fast calls smooths out
+ * the slow ones within it.
+ */
+static void bench_report(const struct bench_ctx* ctx, struct bench_stat* stat, const char* name, size_t size) {
+    if (stat->calls == 0) {
+        return;
+    }
+    qsort(stat->samples, stat->count, sizeof(double), bench_compare_double);
+    double ns_per_op = (double)stat->total_ns / (double)stat->calls;
+    double p50 = stat->samples[stat->count / 2];
+    double p99 = stat->samples[(stat->count * 99) / 100 < stat->count ? (stat->count * 99) / 100 : stat->count - 1];
+    printf("%s,%s,%zu,%zu,%zu,%zu,%.2f,%.0f,%.2f,%.2f\n", name, ctx->variant->name, size, ctx->data_size, stat->calls,
+           stat->batch, ns_per_op,
+           ns_per_op > 0 ? 1e9 / ns_per_op : 0.0, p50, p99);
+    fflush(stdout);
+
+    free(stat->samples);
+    memset(stat, 0, sizeof(*stat));
+}
+
+
+// The benchmarked operations: one call of the library function each. `i` is the call number.
+static void op_create(struct bench_ctx* ctx, size_t i) {
+    (void)i;
+    free_sllist(ctx->variant->create(ctx->data_size));
+}
+
+
+static void op_insert_front(struct bench_ctx* ctx, size_t i) {
+    (void)i;
+    insert_front(ctx->list, ctx->payload);
+}
+
+
+static void op_insert_end(struct bench_ctx* ctx, size_t i) {
+    (void)i;
+    insert_end(ctx->list, ctx->payload);
+}
+
+
+static void op_insert_at_index(struct bench_ctx* ctx, size_t i) {
+    insert_at_index(ctx->list, ctx->payload, ctx->indices[i]);
+}
+
+
+static void op_free_at_front(struct bench_ctx* ctx, size_t i) {
+    (void)i;
+    free_at_front(ctx->list);
+}
+
+
+static void op_free_at_end(struct bench_ctx* ctx, size_t i) {
+    (void)i;
+    free_at_end(ctx->list);
+}
+
+
+static void op_free_at_index(struct bench_ctx* ctx, size_t i) {
+    free_at_index(ctx->list, ctx->indices[i]);
+}
+
+
+static void op_len(struct bench_ctx* ctx, size_t i) {
+    (void)i;
+    ctx->sink = sll_len(ctx->list);
+}
+
+
+static void op_traverse(struct bench_ctx* ctx, size_t i) {
+    (void)i;
+    size_t sum = 0;
+    sllist_iter it = sllist_iter_begin(ctx->list, SLLIST_PREFETCH_DISTANCE);
+    for (unsigned char* data; (data = sllist_iter_get(&it)) != NULL; sllist_iter_next(&it)) {
+        sum += data[0];
+    }
+    ctx->sink = sum;
+}
+
+
+/**
+ * @brief Times an O(n) insert and its matching removal in rounds of at most `size` calls, so the
+ * list never grows beyond twice its nominal size. If `indices` is not NULL, it is filled with a valid
+ * random index for each call.
+ */
+static void bench_walk_pair(struct bench_ctx* ctx, size_t size, uint64_t* rng,
+                            const char* insert_name, void (*insert_op)(struct bench_ctx*, size_t),
+                            const char* remove_name, void (*remove_op)(struct bench_ctx*, size_t),
+                            size_t* indices) {
+    size_t calls = BENCH_WALK_BUDGET / size;
+    calls = calls < 1 ? 1 : calls > BENCH_MAX_WALK_CALLS ? BENCH_MAX_WALK_CALLS : calls;
+
+    struct bench_stat inserts = { 0 };
+    struct bench_stat removes = { 0 };
+    for (size_t done = 0; done < calls;) {
+        size_t round = calls - done < size ? calls - done : size;
+        if (indices != NULL) {
+            // The k-th insert of a round sees size + k elements; the k-th removal, size + round - k.
+            for (size_t k = 0; k < round; k++) {
+                indices[k] = (size_t)(bench_rand(rng) % (size + k + 1));
+            }
+        }
+        bench_run(&inserts, insert_op, ctx, round, bench_walk_batch(size));
+        if (indices != NULL) {
+            for (size_t k = 0; k < round; k++) {
+                indices[k] = (size_t)(bench_rand(rng) % (size + round - k));
+            }
+        }
+        bench_run(&removes, remove_op, ctx, round, bench_walk_batch(size));
+        done += round;
+    }
+    bench_report(ctx, &inserts, insert_name, size);
+    bench_report(ctx, &removes, remove_name, size);
+}
+
+
+/**
+ * @brief Runs every benchmark on a list of `size` elements of `payload` bytes.
+ */
+static void bench_size(struct bench_ctx* ctx, size_t size, size_t payload, uint64_t seed, size_t* indices) {
+    uint64_t rng = seed ^ (size * 0x9E3779B97F4A7C15ull) ^ payload;
+    if (rng == 0) {
+        rng = 1;
+    }
+    ctx->list = ctx->variant->create(payload);
+    ctx->data_size = payload;
+    ctx->indices = indices;
+    if (!ctx->list) {
+        fprintf(stderr, "bench: out of memory\n");
+        exit(1);
+    }
+
+    struct bench_stat stat = { 0 };
+    bench_run(&stat, op_insert_front, ctx, size, BENCH_BATCH);
+    bench_report(ctx, &stat, "insert_front", size);
+    if (sll_len(ctx->list) != size) {
+        fprintf(stderr, "bench: out of memory building a list of %zu elements\n", size);
+        exit(1);
+    }
+
+    size_t walks = BENCH_WALK_BUDGET / size;
+    walks = walks < 1 ? 1 : walks > BENCH_MAX_WALK_CALLS ? BENCH_MAX_WALK_CALLS : walks;
+    bench_run(&stat, op_len, ctx, walks, bench_walk_batch(size));
+    bench_report(ctx, &stat, "sll_len", size);
+    bench_run(&stat, op_traverse, ctx, walks, bench_walk_batch(size));
+    bench_report(ctx, &stat, "traverse", size);
+
+    bench_walk_pair(ctx, size, &rng, "insert_end", op_insert_end, "free_at_end", op_free_at_end, NULL);
+    bench_walk_pair(ctx, size, &rng, "insert_at_index", op_insert_at_index,
+                    "free_at_index", op_free_at_index, indices);
+
+    bench_run(&stat, op_free_at_front, ctx, size, BENCH_BATCH);
+    bench_report(ctx, &stat, "free_at_front", size);
+    free_sllist(ctx->list);
+    ctx->list = NULL;
+}
+
+
+/**
+ * @brief Estimates the heap used by a `variant` list of `size` elements of `payload` bytes.
+ */
+static size_t bench_footprint(const struct bench_variant* variant, size_t size, size_t payload) {
+    size_t slot = payload;
+    if (variant->alignment != 0) {
+        // Rounded up to the alignment, plus room to slide up to an aligned address.
+        slot = ((payload + variant->alignment - 1) & ~(variant->alignment - 1)) + variant->alignment + sizeof(void*);
+    }
+    size_t per_node = 32 + (slot <= sizeof(void*) ? 0 : ((slot + 8 + 15) & ~(size_t)15));
+    return size > SIZE_MAX / (2 * per_node) ? SIZE_MAX : 2 * size * per_node; // Lists grow to twice their size
+}
+
+
+/**
+ * @brief Marks the variants named in the comma-separated `names` in `selected`.
+ *
+ * @return 0 on success, or -1 if a name is not a known variant.
+ */
+static int bench_select_variants(char* names, int* selected) {
+    memset(selected, 0, BENCH_VARIANT_COUNT * sizeof(int));
+    for (char* name = strtok(names, ","); name != NULL; name = strtok(NULL, ",")) {
+        size_t v = 0;
+        while (v < BENCH_VARIANT_COUNT && strcmp(bench_variants[v].name, name) != 0) {
+            v++;
+        }
+        if (v == BENCH_VARIANT_COUNT) {
+            return -1; // Unknown variant
+        }
+        selected[v] = 1;
+    }
+    return 0;
+}
+
+
+static void bench_usage(const char* prog) {
+    fprintf(stderr,
+            "usage: %s [-n max_size] [-p max_payload] [-m memory_mib] [-s seed] [-v variants]\n"
+            "  -n  largest list size, from 10 up in powers of ten (default 10000000)\n"
+            "  -p  largest payload in bytes, from 4 up to 4096 (default 4096)\n"
+            "  -m  skip sizes whose lists would need more than this many MiB (default 2048)\n"
+            "  -s  seed for the random indices (default 1)\n"
+            "  -v  comma-separated list variants: heap, arena, aligned64 (default all)\n",
+            prog);
+}
+
+
+int main(int argc, char** argv) {
+    size_t max_size = 10000000;
+    size_t max_payload = BENCH_MAX_PAYLOAD;
+    size_t memory_limit = (size_t)2048 << 20;
+    uint64_t seed = 1;
+    int selected[BENCH_VARIANT_COUNT];
+    for (size_t v = 0; v < BENCH_VARIANT_COUNT; v++) {
+        selected[v] = 1;
+    }
+
+    int opt;
+    while ((opt = getopt(argc, argv, "n:p:m:s:v:h")) != -1) {
+        switch (opt) {
+        case 'n':
+            max_size = (size_t)strtoull(optarg, NULL, 10);
+            break;
+        case 'p':
+            max_payload = (size_t)strtoull(optarg, NULL, 10);
+            break;
+        case 'm':
+            memory_limit = (size_t)strtoull(optarg, NULL, 10) << 20;
+            break;
+        case 's':
+            seed = (uint64_t)strtoull(optarg, NULL, 10);
+            break;
+        case 'v':
+            if (bench_select_variants(optarg, selected) != 0) {
+                bench_usage(argv[0]);
+                return 2;
+            }
+            break;
+        default:
+            bench_usage(argv[0]);
+            return opt == 'h' ? 0 : 2;
+        }
+    }
+
+    size_t* indices = (size_t*)malloc(BENCH_MAX_WALK_CALLS * sizeof(size_t));
+    struct bench_ctx* ctx = (struct bench_ctx*)calloc(1, sizeof(struct bench_ctx));
+    if (!indices || !ctx) {
+        fprintf(stderr, "bench: out of memory\n");
+        return 1;
+    }
+    for (size_t i = 0; i < BENCH_MAX_PAYLOAD; i++) {
+        ctx->payload[i] = (unsigned char)i;
+    }
+
+    printf("operation,variant,size,payload,calls,batch,ns_per_op,ops_per_sec,batch_p50_ns,batch_p99_ns\n");
+    for (size_t v = 0; v < BENCH_VARIANT_COUNT; v++) {
+        if (!selected[v]) {
+            continue;
+        }
+        ctx->variant = &bench_variants[v];
+        for (size_t p = 0; p < sizeof(bench_payloads) / sizeof(bench_payloads[0]); p++) {
+            size_t payload = bench_payloads[p];
+            if (payload > max_payload) {
+                break;
+            }
+
+            struct bench_stat stat = { 0 };
+            ctx->data_size = payload;
+            bench_run(&stat, op_create, ctx, BENCH_CREATE_CALLS, BENCH_BATCH);
+            bench_report(ctx, &stat, "create", 0);
+
+            for (size_t size = 10; size <= max_size; size *= 10) {
+                if (bench_footprint(ctx->variant, size, payload) > memory_limit) {
+                    fprintf(stderr, "bench: skipping %s size %zu, payload %zu (over the -m memory limit)\n",
+                            ctx->variant->name, size, payload);
+                    break;
+                }
+                fprintf(stderr, "bench: %s size %zu, payload %zu\n", ctx->variant->name, size, payload);
+                bench_size(ctx, size, payload, seed, indices);
+            }
+        }
+    }
+
+    free(ctx);
+    free(indices);
+    return 0;
+}
@@ -0,0 +1,425 @@
+#include <stddef.h> // For max_align_t
+#include <string.h> // For memcpy
+#include "indexlist.h"
+
+
+#define IXL_INITIAL_CAPACITY 16
+
+
+/**
+ * @brief Rounds `size` up to a multiple of `align` (a power of two).
+ */
+static size_t ixl_align_up(size_t size, size_t align) {
+    return (size + align - 1) & ~(align - 1);
+}
+
+
+/**
+ * @brief Returns a pointer to the next-index field of a slot.
+ */
+static uint32_t* ixl_next(const ixlist* list, uint32_t slot) {
+    return (uint32_t*)(list->pool + (size_t)slot * list->stride);
+}
+
+
+/**
+ * @brief Returns a pointer to the payload of a slot.
+ */
+static void* ixl_data(const ixlist* list, uint32_t slot) {
+    return list->pool + (size_t)slot * list->stride + list->payload_offset;
+}
+
+
+/**
+ * @brief Takes a slot from the free chain or the pool, growing the pool if needed.
+ * @return The slot index, or IXLIST_NIL if the pool cannot grow.
+ */
+static uint32_t ixl_alloc_slot(ixlist* list) {
+    if (list->free_head != IXLIST_NIL) {
+        uint32_t slot = list->free_head;
+        list->free_head = *ixl_next(list, slot);
+        return slot;
+    }
+
+    if (list->used == list->capacity) {
+        if (list->capacity == IXLIST_NIL) {
+            return IXLIST_NIL; // Index space exhausted
+        }
+        uint32_t new_capacity = IXL_INITIAL_CAPACITY;
+        if (list->capacity != 0) {
+            new_capacity = list->capacity > IXLIST_NIL / 2 ? IXLIST_NIL : list->capacity * 2;
+        }
+        if (new_capacity > SIZE_MAX / list->stride) {
+            return IXLIST_NIL; // Size overflow
+        }
+
+        unsigned char* pool = (unsigned char*)realloc(list->pool, (size_t)new_capacity * list->stride);
+        if (!pool) {
+            return IXLIST_NIL; // Memory allocation failed
+        }
+        list->pool = pool;
+        list->capacity = new_capacity;
+    }
+    return list->used++;
+}
+
+
+/**
+ * @brief Returns a slot to the free chain.
+ */
+static void ixl_free_slot(ixlist* list, uint32_t slot) {
+    *ixl_next(list, slot) = list->free_head;
+    list->free_head = slot;
+}
+
+
+/**
+ * @brief Allocates a slot holding a copy of `data` and links it after `prev` (or at the front if prev is NIL).
+ */
+static void ixl_link_new(ixlist* list, void* data, uint32_t prev) {
+    uint32_t slot = ixl_alloc_slot(list);
+    if (slot == IXLIST_NIL) {
+        return; // Memory allocation failed
+    }
+    memcpy(ixl_data(list, slot), data, list->data_size);
+
+    if (prev == IXLIST_NIL) {
+        *ixl_next(list, slot) = list->head;
+        list->head = slot;
+    } else {
+        *ixl_next(list, slot) = *ixl_next(list, prev);
+        *ixl_next(list, prev) = slot;
+    }
+    if (prev == list->tail) {
+        list->tail = slot;
+    }
+    list->count++;
+}
+
+
+/**
+ * @brief Unlinks the slot after `prev` (or the front slot if prev is NIL) and recycles it.
+ */
+static void ixl_unlink(ixlist* list, uint32_t prev) {
+    uint32_t victim = prev == IXLIST_NIL ? list->head : *ixl_next(list, prev);
+    uint32_t next = *ixl_next(list, victim);
+
+    if (prev == IXLIST_NIL) {
+        list->head = next;
+    } else {
+        *ixl_next(list, prev) = next;
+    }
+    if (victim == list->tail) {
+        list->tail = prev;
+    }
+    ixl_free_slot(list, victim);
+    list->count--;
+}
+
+
+/**
+ * @brief Returns the slot at position `index`, which must be less than the list length.
+ */
+static uint32_t ixl_slot_at(const ixlist* list, size_t index) {
+    uint32_t slot = list->head;
+    for (size_t i = 0; i < index; i++) {
+        slot = *ixl_next(list, slot);
+    }
+    return slot;
+}
+
+
+/**
+ * @brief Creates a new index-linked list.
+ *
+ * This function initializes an empty list with the specified data size for each node.
+ * The node pool is allocated lazily on the first insertion.
+ *
+ * @param data_size The size of the data to be stored in each node.
+ * @return A pointer to the newly created list, or NULL if memory allocation fails.
+ *
+ * @usage
+ * ixlist* my_list = ixlist_create(sizeof(int));
+ * if (my_list == NULL) {
+ *     // Handle memory allocation failure
+ * }
+ */
+ixlist* ixlist_create(size_t data_size) {
+    ixlist* list = (ixlist*)malloc(sizeof(ixlist));
+    if (!list) {
+        return NULL; // Memory allocation failed
+    }
+
+    // An element type's alignment divides its size, so the lowest set bit of
+    // data_size is a safe payload alignment (capped at what malloc guarantees).
+    size_t align = data_size & (~data_size + 1);
+    if (align == 0 || align > _Alignof(max_align_t)) {
+        align = align == 0 ? 1 : _Alignof(max_align_t);
+    }
+
+    list->pool = NULL;
+    list->data_size = data_size;
+    list->payload_offset = ixl_align_up(sizeof(uint32_t), align);
+    list->stride = ixl_align_up(list->payload_offset + data_size,
+                                align > sizeof(uint32_t) ? align : sizeof(uint32_t));
+    list->capacity = 0;
+    list->used = 0;
+    list->free_head = IXLIST_NIL;
+    list->head = IXLIST_NIL;
+    list->tail = IXLIST_NIL;
+    list->count = 0;
+    return list;
+}
+
+
+/**
+ * @brief Inserts a new node at the front of the list.
+ *
+ * @param list A pointer to the index-linked list.
+ * @param data A pointer to the data to be stored in the new node.
+ *
+ * @usage
+ * ixl_insert_front(my_list, &(int){10}); // Insert 10 at the front
+ */
+void ixl_insert_front(ixlist* list, void* data) {
+    if (!list || !data) {
+        return; // Invalid parameters
+    }
+    ixl_link_new(list, data, IXLIST_NIL);
+}
+
+
+/**
+ * @brief Inserts a new node at the end of the list.
+ *
+ * The list tracks its tail, so this operation does not traverse the list.
+ *
+ * @param list A pointer to the index-linked list.
+ * @param data A pointer to the data to be stored in the new node.
+ *
+ * @usage
+ * ixl_insert_end(my_list, &(int){10}); // Insert 10 at the end
+ */
+void ixl_insert_end(ixlist* list, void* data) {
+    if (!list || !data) {
+        return; // Invalid parameters
+    }
+    ixl_link_new(list, data, list->tail);
+}
+
+
+/**
+ * @brief Inserts a new node at the specified index in the list.
+ *
+ * If the index is 0, the node is inserted at the front. If the index is equal to the length of the list,
+ * the node is inserted at the end. If the index is out of bounds, no insertion is performed.
+ *
+ * @param list A pointer to the index-linked list.
+ * @param data A pointer to the data to be stored in the new node.
+ * @param index The position at which to insert the new node (0-based).
+ *
+ * @usage
+ * ixl_insert_at_index(my_list, &(int){42}, 2); // Insert 42 at index 2
+ */
+void ixl_insert_at_index(ixlist* list, void* data, size_t index) {
+    if (!list || !data) {
+        return; // Invalid parameters
+    }
+    if (index > list->count) {
+        return; // Index out of bounds
+    }
+
+    if (index == 0) {
+        ixl_link_new(list, data, IXLIST_NIL);
+    } else if (index == list->count) {
+        ixl_link_new(list, data, list->tail);
+    } else {
+        ixl_link_new(list, data, ixl_slot_at(list, index - 1));
+    }
+}
+
+
+/**
+ * @brief Frees the entire list, its node pool and the list structure.
+ *
+ * @param list A pointer to the index-linked list to be freed.
+ * @usage
+ * free_ixlist(my_list);
+ */
+void free_ixlist(ixlist* list) {
+    if (!list) {
+        return;
+    }
+    free(list->pool);
+    free(list);
+}
+
+
+/**
+ * @brief Removes the node at the front of the list.
+ *
+ * The slot is recycled by later insertions.
+ *
+ * @param list A pointer to the index-linked list.
+ * @usage
+ * ixl_free_at_front(my_list);
+ */
+void ixl_free_at_front(ixlist* list) {
+    if (!list || list->head == IXLIST_NIL) {
+        return; // List is empty
+    }
+    ixl_unlink(list, IXLIST_NIL);
+}
+
+
+/**
+ * @brief Removes the node at the end of the list.
+ *
+ * @param list A pointer to the index-linked list.
+ * @usage
+ * ixl_free_at_end(my_list);
+ */
+void ixl_free_at_end(ixlist* list) {
+    if (!list || list->head == IXLIST_NIL) {
+        return; // List is empty
+    }
+
+    if (list->count == 1) {
+        ixl_unlink(list, IXLIST_NIL);
+        return;
+    }
+    ixl_unlink(list, ixl_slot_at(list, list->count - 2));
+}
+
+
+/**
+ * @brief Removes the node at the specified index in the list.
+ *
+ * If the index is 0, the front node is removed. If the index is out of bounds, no removal is performed.
+ *
+ * @param list A pointer to the index-linked list.
+ * @param index The position of the node to be removed (0-based).
+ *
+ * @usage
+ * ixl_free_at_index(my_list, 2); // Remove node at index 2
+ */
+void ixl_free_at_index(ixlist* list, size_t index) {
+    if (!list || index >= list->count) {
+        return; // List is empty or index out of bounds
+    }
+
+    if (index == 0) {
+        ixl_unlink(list, IXLIST_NIL);
+        return;
+    }
+    ixl_unlink(list, ixl_slot_at(list, index - 1));
+}
+
+
+/**
+ * @brief Returns the length of the list.
+ *
+ * The list keeps its element count, so this does not traverse the list.
+ *
+ * @param list A pointer to the index-linked list.
+ * @return The number of nodes in the list.
+ *
+ * @usage
+ * size_t length = ixl_len(my_list);
+ */
+size_t ixl_len(ixlist* list) {
+    return list ? list->count : 0;
+}
+
+
+/**
+ * @brief Prints the list.
+ * This function traverses the list and prints each node's data using the provided print function.
+ * @param list A pointer to the index-linked list.
+ * @param print_func A function pointer to a function that takes a void pointer and prints the data.
+ * @usage
+ * void print_int(void* data) {
+ *     printf("%d -> ", *(int*)data);
+ * }
+ * print_ixlist(my_list, print_int);
+ */
+void print_ixlist(ixlist* list, void (*print_func)(void*)) {
+    uint32_t slot = list->head;
+    while (slot != IXLIST_NIL) {
+        print_func(ixl_data(list, slot));
+        slot = *ixl_next(list, slot);
+    }
+    printf("NULL\n");
+}
+
+
+/**
+ * @brief Returns the data of the element at the specified index.
+ *
+ * @param list A pointer to the index-linked list.
+ * @param index The position of the element (0-based).
+ * @return A pointer to the element's data, or NULL if the index is out of bounds.
+ *
+ * @usage
+ * int* third = ixl_get(my_list, 2);
+ */
+void* ixl_get(ixlist* list, size_t index) {
+    if (!list || index >= list->count) {
+        return NULL; // Invalid parameters or index out of bounds
+    }
+    return ixl_data(list, ixl_slot_at(list, index));
+}
+
+
+/**
+ * @brief Returns an iterator positioned at the first element of the list.
+ *
+ * The iterator stays valid until the list is modified.
+ *
+ * @param list A pointer to the index-linked list.
+ * @return An iterator positioned at the first element.
+ *
+ * @usage
+ * ixlist_iter it = ixlist_iter_begin(my_list);
+ * for (int* value; (value = ixlist_iter_get(&it)) != NULL; ixlist_iter_next(&it)) {
+ *     sum += *value;
+ * }
+ */
+ixlist_iter ixlist_iter_begin(ixlist* list) {
+    ixlist_iter it = { list, list ? list->head : IXLIST_NIL };
+    return it;
+}
+
+
+/**
+ * @brief Advances the iterator to the next element.
+ *
+ * Does nothing if the iterator is already exhausted.
+ *
+ * @param it A pointer to the iterator.
+ * @usage
+ * ixlist_iter_next(&it);
+ */
+void ixlist_iter_next(ixlist_iter* it) {
+    if (!it || it->slot == IXLIST_NIL) {
+        return; // Iterator exhausted
+    }
+    it->slot = *ixl_next(it->list, it->slot);
+}
+
+
+/**
+ * @brief Returns the data of the element the iterator is positioned at.
+ *
+ * @param it A pointer to the iterator.
+ * @return A pointer to the element's data, or NULL once the iterator is exhausted.
+ *
+ * @usage
+ * int* value = ixlist_iter_get(&it);
+ */
+void* ixlist_iter_get(ixlist_iter* it) {
+    if (!it || it->slot == IXLIST_NIL) {
+        return NULL; // Iterator exhausted
+    }
+    return ixl_data(it->list, it->slot);
+}
@@ -0,0 +1,234 @@
+#ifndef INDEXLIST_H
+#define INDEXLIST_H
+
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+
+
+/**
+ * @brief Sentinel slot index marking the end of a chain.
+ */
+#define IXLIST_NIL UINT32_MAX
+
+
+/**
+ * @brief Singly linked list whose nodes live in one growable pool and link by 32-bit slot index.
+ *
+ * Each slot stores a uint32_t next index followed by the payload inline, so an element costs
+ * 4 bytes of link (plus alignment padding) instead of two pointers and two heap allocations.
+ * The list holds at most UINT32_MAX - 1 elements.
+ */
+typedef struct ixlist {
+    unsigned char* pool;
+    size_t data_size;
+    size_t payload_offset;
+    size_t stride;
+    uint32_t capacity;
+    uint32_t used;
+    uint32_t free_head;
+    uint32_t head;
+    uint32_t tail;
+    uint32_t count;
+} ixlist;
+
+
+/**
+ * @brief Forward iterator over an index-linked list.
+ */
+typedef struct ixlist_iter {
+    const ixlist* list;
+    uint32_t slot;
+} ixlist_iter;
+
+
+/**
+ * @brief Creates a new index-linked list.
+ *
+ * This function initializes an empty list with the specified data size for each node.
+ * The node pool is allocated lazily on the first insertion.
+ *
+ * @param data_size The size of the data to be stored in each node.
+ * @return A pointer to the newly created list, or NULL if memory allocation fails.
+ *
+ * @usage
+ * ixlist* my_list = ixlist_create(sizeof(int));
+ * if (my_list == NULL) {
+ *     // Handle memory allocation failure
+ * }
+ */
+ixlist* ixlist_create(size_t data_size);
+
+
+/**
+ * @brief Inserts a new node at the front of the list.
+ *
+ * @param list A pointer to the index-linked list.
+ * @param data A pointer to the data to be stored in the new node.
+ *
+ * @usage
+ * ixl_insert_front(my_list, &(int){10}); // Insert 10 at the front
+ */
+void ixl_insert_front(ixlist* list, void* data);
+
+
+/**
+ * @brief Inserts a new node at the end of the list.
+ *
+ * The list tracks its tail, so this operation does not traverse the list.
+ *
+ * @param list A pointer to the index-linked list.
+ * @param data A pointer to the data to be stored in the new node.
+ *
+ * @usage
+ * ixl_insert_end(my_list, &(int){10}); // Insert 10 at the end
+ */
+void ixl_insert_end(ixlist* list, void* data);
+
+
+/**
+ * @brief Inserts a new node at the specified index in the list.
+ *
+ * If the index is 0, the node is inserted at the front. If the index is equal to the length of the list,
+ * the node is inserted at the end. If the index is out of bounds, no insertion is performed.
+ *
+ * @param list A pointer to the index-linked list.
+ * @param data A pointer to the data to be stored in the new node.
+ * @param index The position at which to insert the new node (0-based).
+ *
+ * @usage
+ * ixl_insert_at_index(my_list, &(int){42}, 2); // Insert 42 at index 2
+ */
+void ixl_insert_at_index(ixlist* list, void* data, size_t index);
+
+
+/**
+ * @brief Frees the entire list, its node pool and the list structure.
+ *
+ * @param list A pointer to the index-linked list to be freed.
+ * @usage
+ * free_ixlist(my_list);
+ */
+void free_ixlist(ixlist* list);
+
+
+/**
+ * @brief Removes the node at the front of the list.
+ *
+ * The slot is recycled by later insertions.
+ *
+ * @param list A pointer to the index-linked list.
+ * @usage
+ * ixl_free_at_front(my_list);
+ */
+void ixl_free_at_front(ixlist* list);
+
+
+/**
+ * @brief Removes the node at the end of the list.
+ *
+ * @param list A pointer to the index-linked list.
+ * @usage
+ * ixl_free_at_end(my_list);
+ */
+void ixl_free_at_end(ixlist* list);
+
+
+/**
+ * @brief Removes the node at the specified index in the list.
+ *
+ * If the index is 0, the front node is removed. If the index is out of bounds, no removal is performed.
+ *
+ * @param list A pointer to the index-linked list.
+ * @param index The position of the node to be removed (0-based).
+ *
+ * @usage
+ * ixl_free_at_index(my_list, 2); // Remove node at index 2
+ */
+void ixl_free_at_index(ixlist* list, size_t index);
+
+
+/**
+ * @brief Returns the length of the list.
+ *
+ * The list keeps its element count, so this does not traverse the list.
+ *
+ * @param list A pointer to the index-linked list.
+ * @return The number of nodes in the list.
+ *
+ * @usage
+ * size_t length = ixl_len(my_list);
+ */
+size_t ixl_len(ixlist* list);
+
+
+/**
+ * @brief Prints the list.
+ * This function traverses the list and prints each node's data using the provided print function.
+ * @param list A pointer to the index-linked list.
+ * @param print_func A function pointer to a function that takes a void pointer and prints the data.
+ * @usage
+ * void print_int(void* data) {
+ *     printf("%d -> ", *(int*)data);
+ * }
+ * print_ixlist(my_list, print_int);
+ */
+void print_ixlist(ixlist* list, void (*print_func)(void*));
+
+
+/**
+ * @brief Returns the data of the element at the specified index.
+ *
+ * @param list A pointer to the index-linked list.
+ * @param index The position of the element (0-based).
+ * @return A pointer to the element's data, or NULL if the index is out of bounds.
+ *
+ * @usage
+ * int* third = ixl_get(my_list, 2);
+ */
+void* ixl_get(ixlist* list, size_t index);
+
+
+/**
+ * @brief Returns an iterator positioned at the first element of the list.
+ *
+ * The iterator stays valid until the list is modified.
+ *
+ * @param list A pointer to the index-linked list.
+ * @return An iterator positioned at the first element.
+ *
+ * @usage
+ * ixlist_iter it = ixlist_iter_begin(my_list);
+ * for (int* value; (value = ixlist_iter_get(&it)) != NULL; ixlist_iter_next(&it)) {
+ *     sum += *value;
+ * }
+ */
+ixlist_iter ixlist_iter_begin(ixlist* list);
+
+
+/**
+ * @brief Advances the iterator to the next element.
+ *
+ * Does nothing if the iterator is already exhausted.
+ *
+ * @param it A pointer to the iterator.
+ * @usage
+ * ixlist_iter_next(&it);
+ */
+void ixlist_iter_next(ixlist_iter* it);
+
+
+/**
+ * @brief Returns the data of the element the iterator is positioned at.
+ *
+ * @param it A pointer to the iterator.
+ * @return A pointer to the element's data, or NULL once the iterator is exhausted.
+ *
+ * @usage
+ * int* value = ixlist_iter_get(&it);
+ */
+void* ixlist_iter_get(ixlist_iter* it);
+
+
+#endif // INDEXLIST_H
@@ -0,0 +1,597 @@
+#define _POSIX_C_SOURCE 200809L // For fsync, fileno, ftruncate
+#include <errno.h>
+#include <fcntl.h>
+#include <stdint.h>
+#include <string.h> // For memcpy, memcmp
+#include <unistd.h>
+#include "journal.h"
+
+
+#define JNL_SNAPSHOT_MAGIC "SLLJSNAP"
+#define JNL_LOG_MAGIC "SLLJLOG"
+#define JNL_INSERT 1u
+#define JNL_DELETE 2u
+
+
+/**
+ * @brief Header preceding the sllist_save() image in a snapshot file, and the log file header.
+ *
+ * A log only applies on top of the snapshot with the same generation.
+ */
+struct jnl_file_header {
+    char magic[8];
+    uint64_t generation;
+};
+
+
+/**
+ * @brief Log record header. Insert records are followed by `data_size` bytes of payload.
+ */
+struct jnl_record {
+    uint32_t crc;
+    uint32_t type;
+    uint64_t index;
+};
+
+
+/**
+ * @brief Updates a CRC-32 (IEEE) checksum with `size` bytes.
+ */
+static uint32_t jnl_crc32(uint32_t crc, const void* data, size_t size) {
+    static uint32_t table[256];
+    static int table_ready = 0;
+    if (!table_ready) {
+        for (uint32_t i = 0; i < 256; i++) {
+            uint32_t c = i;
+            for (int k = 0; k < 8; k++) {
+                c = (c & 1) ? 0xEDB88320u ^ (c >> 1) : c >> 1;
+            }
+            table[i] = c;
+        }
+        table_ready = 1;
+    }
+
+    const unsigned char* bytes = (const unsigned char*)data;
+    crc = ~crc;
+    for (size_t i = 0; i < size; i++) {
+        crc = table[(crc ^ bytes[i]) & 0xFF] ^ (crc >> 8);
+    }
+    return ~crc;
+}
+
+
+/**
+ * @brief Computes the checksum of a record: its type, index and payload.
+ */
+static uint32_t jnl_record_crc(const struct jnl_record* record, const void* data, size_t data_size) {
+    uint32_t crc = jnl_crc32(0, &record->type, sizeof(record->type));
+    crc = jnl_crc32(crc, &record->index, sizeof(record->index));
+    return data ? jnl_crc32(crc, data, data_size) : crc;
+}
+
+
+/**
+ * @brief Returns a newly allocated copy of `s` followed by `suffix` (which may be NULL).
+ */
+static char* jnl_strdup(const char* s, const char* suffix) {
+    size_t len = strlen(s);
+    size_t suffix_len = suffix ? strlen(suffix) : 0;
+    char* copy = (char*)malloc(len + suffix_len + 1);
+    if (!copy) {
+        return NULL; // Memory allocation failed
+    }
+    memcpy(copy, s, len);
+    if (suffix) {
+        memcpy(copy + len, suffix, suffix_len);
+    }
+    copy[len + suffix_len] = '\0';
+    return copy;
+}
+
+
+/**
+ * @brief Flushes the directory containing `path` so that a rename into it is durable.
+ */
+static void jnl_sync_dir(const char* path) {
+    char* dir = jnl_strdup(path, NULL);
+    if (!dir) {
+        return;
+    }
+    char* slash = strrchr(dir, '/');
+    if (slash) {
+        slash[slash == dir ? 1 : 0] = '\0'; // Keep "/" itself for files in the root
+    }
+
+    int fd = open(slash ? dir : ".", O_RDONLY);
+    if (fd >= 0) {
+        fsync(fd);
+        close(fd);
+    }
+    free(dir);
+}
+
+
+/**
+ * @brief Writes buffered log records and flushes them to storage.
+ */
+static int jnl_flush(sll_journal* journal) {
+    if (fflush(journal->log) != 0 || fsync(fileno(journal->log)) != 0) {
+        return -1;
+    }
+    journal->pending = 0;
+    return 0;
+}
+
+
+/**
+ * @brief Empties the log and stamps it with the journal's generation.
+ */
+static int jnl_reset_log(sll_journal* journal) {
+    struct jnl_file_header header;
+    memcpy(header.magic, JNL_LOG_MAGIC, sizeof(header.magic));
+    header.generation = journal->generation;
+
+    if (fflush(journal->log) != 0 || ftruncate(fileno(journal->log), 0) != 0) {
+        return -1;
+    }
+    if (fwrite(&header, sizeof(header), 1, journal->log) != 1) {
+        return -1;
+    }
+    journal->log_bytes = 0;
+    return jnl_flush(journal);
+}
+
+
+/**
+ * @brief Loads the snapshot into `journal->list`, or starts an empty list if there is none.
+ *
+ * Only a snapshot that does not exist counts as none: if it exists but cannot be read, starting
+ * empty would discard every committed operation it holds.
+ */
+static int jnl_load_snapshot(sll_journal* journal, size_t data_size) {
+    FILE* fp = fopen(journal->snapshot_path, "rb");
+    if (!fp) {
+        if (errno != ENOENT) {
+            return -1; // Snapshot exists but cannot be opened
+        }
+        journal->list = sllist_create(data_size);
+        journal->generation = 0;
+        return journal->list ? 0 : -1;
+    }
+
+    struct jnl_file_header header;
+    if (fread(&header, sizeof(header), 1, fp) != 1 ||
+        memcmp(header.magic, JNL_SNAPSHOT_MAGIC, sizeof(header.magic)) != 0) {
+        fclose(fp);
+        return -1; // Not a journal snapshot
+    }
+    journal->generation = header.generation;
+    journal->list = sllist_load(fp);
+    fclose(fp);
+
+    if (!journal->list || journal->list->data_size != data_size) {
+        return -1; // Unreadable, or created for another element size
+    }
+    // Counted here rather than with sll_len(), which would show up as a caller's operation in the list's stats.
+    for (const sll_node* node = journal->list->head; node != NULL; node = node->next) {
+        journal->count++;
+    }
+    return 0;
+}
+
+
+/**
+ * @brief Applies the log on top of the loaded snapshot.
+ *
+ * A log older than the snapshot was folded into it by a checkpoint and may be discarded. A log newer
+ * than the snapshot means the snapshot it applies to is missing, so the journal must not open.
+ *
+ * @return The offset just past the last intact record, 0 if the log is missing, empty or stale,
+ *         or -1 if it cannot be read or is newer than the snapshot.
+ */
+static long jnl_replay(sll_journal* journal) {
+    FILE* fp = fopen(journal->log_path, "rb");
+    if (!fp) {
+        return errno == ENOENT ? 0 : -1;
+    }
+
+    struct jnl_file_header header;
+    if (fread(&header, sizeof(header), 1, fp) != 1) {
+        int failed = ferror(fp);
+        fclose(fp);
+        return failed ? -1 : 0; // Read error, or a log whose header was never written
+    }
+    if (memcmp(header.magic, JNL_LOG_MAGIC, sizeof(header.magic)) != 0 || header.generation > journal->generation) {
+        fclose(fp);
+        return -1; // Not a log, or written after a snapshot that is now missing
+    }
+    if (header.generation != journal->generation) {
+        fclose(fp);
+        return 0; // Already folded into the snapshot
+    }
+
+    size_t data_size = journal->list->data_size;
+    void* payload = malloc(data_size ? data_size : 1);
+    long good_end = ftell(fp);
+    struct jnl_record record;
+    while (payload && fread(&record, sizeof(record), 1, fp) == 1) {
+        int insert = record.type == JNL_INSERT;
+        if (!insert && record.type != JNL_DELETE) {
+            break; // Garbage
+        }
+        if (insert && data_size != 0 && fread(payload, data_size, 1, fp) != 1) {
+            break; // Torn record
+        }
+        if (record.crc != jnl_record_crc(&record, insert ? payload : NULL, data_size)) {
+            break; // Torn record
+        }
+
+        if (insert && record.index <= journal->count) {
+            insert_at_index(journal->list, payload, (size_t)record.index);
+            journal->count++;
+        } else if (!insert && record.index < journal->count) {
+            free_at_index(journal->list, (size_t)record.index);
+            journal->count--;
+        } else {
+            break; // Inconsistent with the snapshot
+        }
+        good_end = ftell(fp);
+    }
+
+    free(payload);
+    fclose(fp);
+    return good_end;
+}
+
+
+/**
+ * @brief Cuts the log back to the end of its last complete record, `log_bytes` past the header.
+ *
+ * Anything after it would otherwise sit in front of later records: recovery stops at the first bad
+ * record, so every record appended after a torn one would be lost. If the log cannot be cut,
+ * `log_damaged` is set and the journal refuses operations until a checkpoint rewrites it.
+ */
+static int jnl_truncate_log(sll_journal* journal) {
+    clearerr(journal->log);
+    if (fflush(journal->log) != 0 ||
+        ftruncate(fileno(journal->log), (off_t)(sizeof(struct jnl_file_header) + journal->log_bytes)) != 0) {
+        journal->log_damaged = 1;
+        return -1;
+    }
+    return 0;
+}
+
+
+/**
+ * @brief Returns the size of the record jnl_append() writes for an operation of `type`.
+ */
+static size_t jnl_record_size(const sll_journal* journal, uint32_t type) {
+    return sizeof(struct jnl_record) + (type == JNL_INSERT ? journal->list->data_size : 0);
+}
+
+
+/**
+ * @brief Appends a record for an operation that is about to be applied.
+ *
+ * A record that cannot be written whole is cut from the log again.
+ */
+static int jnl_append(sll_journal* journal, uint32_t type, size_t index, const void* data) {
+    struct jnl_record record;
+    record.type = type;
+    record.index = index;
+    record.crc = jnl_record_crc(&record, data, journal->list->data_size);
+
+    if (fwrite(&record, sizeof(record), 1, journal->log) != 1 ||
+        (type == JNL_INSERT && journal->list->data_size != 0 &&
+         fwrite(data, journal->list->data_size, 1, journal->log) != 1)) {
+        jnl_truncate_log(journal);
+        return -1; // Write failed
+    }
+    journal->log_bytes += jnl_record_size(journal, type);
+    journal->pending++;
+    return 0;
+}
+
+
+/**
+ * @brief Takes back the record just appended for an operation that could not be applied.
+ */
+static void jnl_unappend(sll_journal* journal, uint32_t type) {
+    journal->log_bytes -= jnl_record_size(journal, type);
+    journal->pending--;
+    jnl_truncate_log(journal);
+}
+
+
+/**
+ * @brief Returns the node at `index` of the list, or NULL if the list is that short.
+ *
+ * The list functions do not report allocation failures, so the journal compares the node found here
+ * before and after an operation to learn whether it was applied. Nodes before `index` may be copied
+ * by the operation if the list shares them with a clone; the node at `index` itself never is.
+ */
+static const sll_node* jnl_node_at(const sllist* list, size_t index) {
+    const sll_node* node = list->head;
+    for (size_t i = 0; i < index && node != NULL; i++) {
+        node = node->next;
+    }
+    return node;
+}
+
+
+/**
+ * @brief Frees a journal whose log may not be open yet.
+ */
+static void jnl_destroy(sll_journal* journal) {
+    if (journal->log) {
+        fclose(journal->log);
+    }
+    if (journal->list) {
+        free_sllist(journal->list);
+    }
+    free(journal->snapshot_path);
+    free(journal->log_path);
+    free(journal);
+}
+
+
+/**
+ * @brief Opens a journaled list, recovering its state from the snapshot and the log.
+ *
+ * Missing files are created. Records after the last complete, intact one are discarded. Opening
+ * fails rather than drop committed data if a file exists but cannot be read, or if the log was
+ * written after a snapshot that is now missing.
+ *
+ * @param snapshot_path Path of the snapshot file.
+ * @param log_path Path of the operation log.
+ * @param data_size The size of the data stored in each node.
+ * @return A pointer to the journal, or NULL if the files cannot be read or written, or hold a different element size.
+ *
+ * @usage
+ * sll_journal* jobs = sll_journal_open("jobs.snap", "jobs.log", sizeof(job));
+ * if (jobs == NULL) {
+ *     // Handle failure
+ * }
+ */
+sll_journal* sll_journal_open(const char* snapshot_path, const char* log_path, size_t data_size) {
+    if (!snapshot_path || !log_path) {
+        return NULL; // Invalid parameters
+    }
+
+    sll_journal* journal = (sll_journal*)calloc(1, sizeof(sll_journal));
+    if (!journal) {
+        return NULL; // Memory allocation failed
+    }
+    journal->batch_size = SLL_JOURNAL_BATCH;
+    journal->checkpoint_bytes = SLL_JOURNAL_CHECKPOINT_BYTES;
+    journal->snapshot_path = jnl_strdup(snapshot_path, NULL);
+    journal->log_path = jnl_strdup(log_path, NULL);
+    if (!journal->snapshot_path || !journal->log_path || jnl_load_snapshot(journal, data_size) != 0) {
+        jnl_destroy(journal);
+        return NULL;
+    }
+
+    long good_end = jnl_replay(journal);
+    if (good_end < 0) {
+        jnl_destroy(journal);
+        return NULL;
+    }
+
+    // Cut off anything after the last intact record so new records follow valid ones.
+    int fd = open(log_path, O_RDWR | O_CREAT, 0644);
+    if (fd < 0 || ftruncate(fd, good_end) != 0) {
+        if (fd >= 0) {
+            close(fd);
+        }
+        jnl_destroy(journal);
+        return NULL;
+    }
+    journal->log = fdopen(fd, "ab");
+    if (!journal->log) {
+        close(fd);
+        jnl_destroy(journal);
+        return NULL;
+    }
+
+    if (good_end == 0 && jnl_reset_log(journal) != 0) {
+        jnl_destroy(journal);
+        return NULL;
+    }
+    journal->log_bytes = good_end > 0 ? (size_t)good_end - sizeof(struct jnl_file_header) : 0;
+    return journal;
+}
+
+
+/**
+ * @brief Sets the group-commit batch size and the automatic checkpoint threshold.
+ *
+ * @param journal A pointer to the journal.
+ * @param batch_size Number of pending records that triggers a commit (1 commits every operation).
+ * @param checkpoint_bytes Log size that triggers a checkpoint after a commit (0 disables automatic checkpoints).
+ *
+ * @usage
+ * sll_journal_configure(jobs, 256, 16 * 1024 * 1024);
+ */
+void sll_journal_configure(sll_journal* journal, size_t batch_size, size_t checkpoint_bytes) {
+    if (!journal) {
+        return; // Invalid parameters
+    }
+    journal->batch_size = batch_size ? batch_size : 1;
+    journal->checkpoint_bytes = checkpoint_bytes;
+}
+
+
+/**
+ * @brief Logs and applies an insertion, as insert_at_index().
+ *
+ * @param journal A pointer to the journal.
+ * @param data A pointer to the data to be stored in the new node.
+ * @param index The position at which to insert the new node (0-based).
+ * @return 0 on success, or -1 if the index is out of bounds, the record cannot be written, or
+ *         memory allocation fails. On failure neither the list nor the log is changed.
+ *
+ * @usage
+ * sll_journal_insert_at_index(jobs, &next_job, sll_journal_len(jobs));
+ */
+int sll_journal_insert_at_index(sll_journal* journal, void* data, size_t index) {
+    if (!journal || !data || index > journal->count || journal->log_damaged) {
+        return -1; // Invalid parameters, index out of bounds, or log awaiting a checkpoint
+    }
+    if (jnl_append(journal, JNL_INSERT, index, data) != 0) {
+        return -1;
+    }
+
+    const sll_node* displaced = jnl_node_at(journal->list, index);
+    insert_at_index(journal->list, data, index);
+    if (jnl_node_at(journal->list, index) == displaced) {
+        jnl_unappend(journal, JNL_INSERT);
+        return -1; // Memory allocation failed
+    }
+    journal->count++;
+    return journal->pending >= journal->batch_size ? sll_journal_commit(journal) : 0;
+}
+
+
+/**
+ * @brief Logs and applies a removal, as free_at_index().
+ *
+ * @param journal A pointer to the journal.
+ * @param index The position of the node to be removed (0-based).
+ * @return 0 on success, or -1 if the index is out of bounds, the record cannot be written, or
+ *         memory allocation fails (when a clone shares the list). On failure neither the list nor the
+ *         log is changed.
+ *
+ * @usage
+ * sll_journal_free_at_index(jobs, 0);
+ */
+int sll_journal_free_at_index(sll_journal* journal, size_t index) {
+    if (!journal || index >= journal->count || journal->log_damaged) {
+        return -1; // Invalid parameters, index out of bounds, or log awaiting a checkpoint
+    }
+    if (jnl_append(journal, JNL_DELETE, index, NULL) != 0) {
+        return -1;
+    }
+
+    const sll_node* victim = jnl_node_at(journal->list, index);
+    free_at_index(journal->list, index);
+    if (jnl_node_at(journal->list, index) == victim) {
+        jnl_unappend(journal, JNL_DELETE);
+        return -1; // Memory allocation failed copying a node shared with a clone
+    }
+    journal->count--;
+    return journal->pending >= journal->batch_size ? sll_journal_commit(journal) : 0;
+}
+
+
+/**
+ * @brief Returns the number of elements in the journaled list.
+ *
+ * @param journal A pointer to the journal.
+ * @return The number of nodes in the list.
+ *
+ * @usage
+ * size_t length = sll_journal_len(jobs);
+ */
+size_t sll_journal_len(sll_journal* journal) {
+    return journal ? journal->count : 0;
+}
+
+
+/**
+ * @brief Makes every logged operation durable.
+ *
+ * May also write a checkpoint if the log has outgrown the configured threshold.
+ *
+ * @param journal A pointer to the journal.
+ * @return 0 on success, or -1 if the log cannot be flushed to storage.
+ *
+ * @usage
+ * sll_journal_commit(jobs);
+ */
+int sll_journal_commit(sll_journal* journal) {
+    if (!journal) {
+        return -1; // Invalid parameters
+    }
+    if (jnl_flush(journal) != 0) {
+        return -1;
+    }
+    if (journal->checkpoint_bytes != 0 && journal->log_bytes >= journal->checkpoint_bytes) {
+        sll_journal_checkpoint(journal); // The log is durable either way
+    }
+    return 0;
+}
+
+
+/**
+ * @brief Writes the list to a new snapshot and empties the log.
+ *
+ * The snapshot is written to a temporary file and renamed into place, so a crash leaves either
+ * the old or the new snapshot together with a log that matches it.
+ *
+ * @param journal A pointer to the journal.
+ * @return 0 on success, or -1 on failure (the previous snapshot and log remain usable).
+ *
+ * @usage
+ * sll_journal_checkpoint(jobs);
+ */
+int sll_journal_checkpoint(sll_journal* journal) {
+    if (!journal) {
+        return -1; // Invalid parameters
+    }
+    // Pending records must reach the log before it is emptied, never after.
+    if (jnl_flush(journal) != 0) {
+        return -1;
+    }
+
+    char* tmp_path = jnl_strdup(journal->snapshot_path, ".tmp");
+    if (!tmp_path) {
+        return -1; // Memory allocation failed
+    }
+    FILE* fp = fopen(tmp_path, "wb");
+    if (!fp) {
+        free(tmp_path);
+        return -1;
+    }
+
+    struct jnl_file_header header;
+    memcpy(header.magic, JNL_SNAPSHOT_MAGIC, sizeof(header.magic));
+    header.generation = journal->generation + 1;
+    int failed = fwrite(&header, sizeof(header), 1, fp) != 1 ||
+                 sllist_save(journal->list, fp) != 0 ||
+                 fflush(fp) != 0 || fsync(fileno(fp)) != 0;
+    failed |= fclose(fp) != 0;
+    if (failed || rename(tmp_path, journal->snapshot_path) != 0) {
+        remove(tmp_path);
+        free(tmp_path);
+        return -1;
+    }
+    free(tmp_path);
+    jnl_sync_dir(journal->snapshot_path);
+
+    // From here on the old log no longer matches the snapshot and is ignored on recovery.
+    journal->generation++;
+    if (jnl_reset_log(journal) != 0) {
+        return -1;
+    }
+    journal->log_damaged = 0; // The snapshot holds everything; the damaged log is gone
+    return 0;
+}
+
+
+/**
+ * @brief Commits pending records, closes the log and frees the journal and its list.
+ *
+ * @param journal A pointer to the journal.
+ * @return 0 if the final commit succeeded, or -1 otherwise.
+ *
+ * @usage
+ * sll_journal_close(jobs);
+ */
+int sll_journal_close(sll_journal* journal) {
+    if (!journal) {
+        return -1; // Invalid parameters
+    }
+    int result = jnl_flush(journal);
+    jnl_destroy(journal);
+    return result;
+}
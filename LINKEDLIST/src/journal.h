@@ -0,0 +1,164 @@
+#ifndef JOURNAL_H
+#define JOURNAL_H
+
+
+#include <stdio.h>
+#include <stdlib.h>
+#include "linkedlist.h"
+
+
+/**
+ * @brief Default number of records buffered before the journal commits on its own.
+ */
+#define SLL_JOURNAL_BATCH 64
+
+
+/**
+ * @brief Default log size (in bytes) after which a commit also writes a new snapshot.
+ */
+#define SLL_JOURNAL_CHECKPOINT_BYTES ((size_t)64 * 1024 * 1024)
+
+
+/**
+ * @brief A singly linked list persisted as a snapshot plus an append-only operation log.
+ *
+ * Every insertion and removal is appended to the log before it is applied to `list`. Records are
+ * buffered and made durable together (group commit) once `batch_size` of them are pending or when
+ * sll_journal_commit() is called. When the log outgrows `checkpoint_bytes`, the list is written to a
+ * new snapshot with sllist_save() and the log starts over. Reopening the journal loads the snapshot
+ * and replays the log, ignoring a torn record at its end. A record whose write or operation fails is
+ * cut from the log again; if that fails too, `log_damaged` is set and insertions and removals are
+ * refused until a checkpoint replaces the log.
+ *
+ * Read the list through `list`; modify it only through the journal functions.
+ */
+typedef struct sll_journal {
+    sllist* list;
+    FILE* log;
+    char* snapshot_path;
+    char* log_path;
+    unsigned long long generation;
+    size_t count;
+    size_t pending;
+    size_t batch_size;
+    size_t log_bytes;
+    size_t checkpoint_bytes;
+    int log_damaged;
+} sll_journal;
+
+
+/**
+ * @brief Opens a journaled list, recovering its state from the snapshot and the log.
+ *
+ * Missing files are created. Records after the last complete, intact one are discarded. Opening
+ * fails rather than drop committed data if a file exists but cannot be read, or if the log was
+ * written after a snapshot that is now missing.
+ *
+ * @param snapshot_path Path of the snapshot file.
+ * @param log_path Path of the operation log.
+ * @param data_size The size of the data stored in each node.
+ * @return A pointer to the journal, or NULL if the files cannot be read or written, or hold a different element size.
+ *
+ * @usage
+ * sll_journal* jobs = sll_journal_open("jobs.snap", "jobs.log", sizeof(job));
+ * if (jobs == NULL) {
+ *     // Handle failure
+ * }
+ */
+sll_journal* sll_journal_open(const char* snapshot_path, const char* log_path, size_t data_size);
+
+
+/**
+ * @brief Sets the group-commit batch size and the automatic checkpoint threshold.
+ *
+ * @param journal A pointer to the journal.
+ * @param batch_size Number of pending records that triggers a commit (1 commits every operation).
+ * @param checkpoint_bytes Log size that triggers a checkpoint after a commit (0 disables automatic checkpoints).
+ *
+ * @usage
+ * sll_journal_configure(jobs, 256, 16 * 1024 * 1024);
+ */
+void sll_journal_configure(sll_journal* journal, size_t batch_size, size_t checkpoint_bytes);
+
+
+/**
+ * @brief Logs and applies an insertion, as insert_at_index().
+ *
+ * @param journal A pointer to the journal.
+ * @param data A pointer to the data to be stored in the new node.
+ * @param index The position at which to insert the new node (0-based).
+ * @return 0 on success, or -1 if the index is out of bounds or the record cannot be written.
+ *
+ * @usage
+ * sll_journal_insert_at_index(jobs, &next_job, sll_journal_len(jobs));
+ */
+int sll_journal_insert_at_index(sll_journal* journal, void* data, size_t index);
+
+
+/**
+ * @brief Logs and applies a removal, as free_at_index().
+ *
+ * @param journal A pointer to the journal.
+ * @param index The position of the node to be removed (0-based).
+ * @return 0 on success, or -1 if the index is out of bounds or the record cannot be written.
+ *
+ * @usage
+ * sll_journal_free_at_index(jobs, 0);
+ */
+int sll_journal_free_at_index(sll_journal* journal, size_t index);
+
+
+/**
+ * @brief Returns the number of elements in the journaled list.
+ *
+ * @param journal A pointer to the journal.
+ * @return The number of nodes in the list.
+ *
+ * @usage
+ * size_t length = sll_journal_len(jobs);
+ */
+size_t sll_journal_len(sll_journal* journal);
+
+
+/**
+ * @brief Makes every logged operation durable.
+ *
+ * May also write a checkpoint if the log has outgrown the configured threshold.
+ *
+ * @param journal A pointer to the journal.
+ * @return 0 on success, or -1 if the log cannot be flushed to storage.
+ *
+ * @usage
+ * sll_journal_commit(jobs);
+ */
+int sll_journal_commit(sll_journal* journal);
+
+
+/**
+ * @brief Writes the list to a new snapshot and empties the log.
+ *
+ * The snapshot is written to a temporary file and renamed into place, so a crash leaves either
+ * the old or the new snapshot together with a log that matches it.
+ *
+ * @param journal A pointer to the journal.
+ * @return 0 on success, or -1 on failure (the previous snapshot and log remain usable).
+ *
+ * @usage
+ * sll_journal_checkpoint(jobs);
+ */
+int sll_journal_checkpoint(sll_journal* journal);
+
+
+/**
+ * @brief Commits pending records, closes the log and frees the journal and its list.
+ *
+ * @param journal A pointer to the journal.
+ * @return 0 if the final commit succeeded, or -1 otherwise.
+ *
+ * @usage
+ * sll_journal_close(jobs);
+ */
+int sll_journal_close(sll_journal* journal);
+
+
+#endif // JOURNAL_H
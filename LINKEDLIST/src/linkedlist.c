@@ -1,329 +1,2600 @@
+#define _GNU_SOURCE // For syscall()
+#include <stddef.h> // For max_align_t
+#include <stdint.h> // For uintptr_t, SIZE_MAX
 #include <string.h> // For memcpy
+#include <pthread.h> // For the background reclaimer
+#include <time.h> // For clock_gettime
+#ifdef __linux__
+#include <linux/mempolicy.h> // For MPOL_BIND, MPOL_MF_MOVE
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#else
+#define MPOL_MF_MOVE 0 // Never used: NUMA binding always fails without Linux
+#endif
+#ifdef SLLIST_USDT
+#include <sys/sdt.h> // For STAP_PROBE3 (systemtap-sdt-dev)
+#endif
 #include "linkedlist.h"
 
 
+#if defined(__GNUC__) || defined(__clang__)
+#define SLL_PREFETCH(addr) __builtin_prefetch((addr), 0, 3)
+#else
+#define SLL_PREFETCH(addr) ((void)(addr))
+#endif
+
+
+// Nodes and slabs can be shared between a list and its clones, possibly on different threads.
+#if defined(__GNUC__) || defined(__clang__)
+#define SLL_REF_INC(obj) __atomic_add_fetch(&(obj)->refs, 1, __ATOMIC_RELAXED)
+#define SLL_REF_DEC(obj) __atomic_sub_fetch(&(obj)->refs, 1, __ATOMIC_ACQ_REL)
+#define SLL_REF_SHARED(obj) (__atomic_load_n(&(obj)->refs, __ATOMIC_ACQUIRE) > 1)
+#else
+#define SLL_REF_INC(obj) (++(obj)->refs)
+#define SLL_REF_DEC(obj) (--(obj)->refs)
+#define SLL_REF_SHARED(obj) ((obj)->refs > 1)
+#endif
+
+
+/**
+ * @brief Non-zero if the list's payloads are stored in the node's data field itself: they fit in a
+ * pointer and need no more than a pointer's alignment.
+ */
+#define SLL_INLINE_DATA(list) ((list)->data_size <= sizeof(void*) && (list)->alignment <= sizeof(void*))
+
+
+/**
+ * @brief Contiguous block holding `count` nodes followed by their payloads, in list order.
+ *
+ * `refs` counts the lists (a list and its clones) that may reach nodes in the slab.
+ */
+struct sll_slab {
+    size_t refs;
+    size_t count;
+    sll_node nodes[];
+};
+
+
+#define SLL_ARENA_FIRST_CHUNK ((size_t)64 * 1024)
+#define SLL_ARENA_MAX_CHUNK ((size_t)4 * 1024 * 1024)
+
+
+/**
+ * @brief Block of memory handed out by an arena, newest first in the arena's chain.
+ */
+struct sll_arena_chunk {
+    struct sll_arena_chunk* next;
+    size_t size;
+    size_t used;
+    _Alignas(max_align_t) unsigned char data[];
+};
+
+
+/**
+ * @brief List created by sllist_create_arena(), together with the bump allocator its memory comes from.
+ *
+ * The list is the first member, so a list and its arena share an address.
+ */
+struct sll_arena {
+    sllist list;
+    struct sll_arena_chunk* chunks;
+    size_t next_chunk_size;
+    int numa_node; // Node the chunks are bound to, or -1 for plain malloc() chunks
+    int huge_pages; // Non-zero if chunks are huge-page aligned and advised as such
+};
+
+
+#define SLL_HUGE_PAGE_SIZE ((size_t)2 * 1024 * 1024)
+
+
+#define SLL_NUMA_MAX_NODES 1024
+#define SLL_MOVE_BATCH 256 // Pages passed to one move_pages() call
+
+
+/**
+ * @brief List waiting to be freed by the background reclaimer.
+ */
+struct sll_reclaim_item {
+    sllist* list;
+    struct sll_reclaim_item* next;
+};
+
+
+/**
+ * @brief Queue of lists handed to sllist_free_async(), drained by a thread started on first use.
+ */
+static struct {
+    pthread_mutex_t lock;
+    pthread_cond_t work; // Signalled when lists are queued
+    pthread_cond_t idle; // Broadcast when the queue has been drained
+    struct sll_reclaim_item* pending;
+    int busy;
+    int started;
+} sll_reclaimer = { PTHREAD_MUTEX_INITIALIZER, PTHREAD_COND_INITIALIZER, PTHREAD_COND_INITIALIZER, NULL, 0, 0 };
+static pthread_once_t sll_fork_once = PTHREAD_ONCE_INIT;
+
+
+// Blocks of up to SLL_CACHE_CLASSES * SLL_CACHE_GRANULE + 8 bytes are recycled through per-thread caches.
+// Class sizes are 16n + 8, the usable sizes of malloc chunks with an 8-byte header and 16-byte rounding.
+#define SLL_CACHE_GRANULE 16
+#define SLL_CACHE_CLASSES 16
+#define SLL_CACHE_BATCH 64 // Blocks moved between a thread cache and the depot at a time
+#define SLL_DEPOT_BATCHES 64 // Batches the depot holds per size class
+
+
+/**
+ * @brief Chain of free blocks of one size class, linked through their first word.
+ */
+struct sll_cache_bin {
+    void* head;
+    size_t count;
+};
+
+
+/**
+ * @brief This thread's free blocks, one bin per size class, and whether its exit handler is registered.
+ */
+static _Thread_local struct sll_cache_bin sll_cache[SLL_CACHE_CLASSES];
+static _Thread_local int sll_cache_registered;
+
+
+/**
+ * @brief Shared overflow of the thread caches: whole batches per size class, so blocks freed on
+ * one thread (or left by an exiting one) are reused by others.
+ */
+static struct {
+    size_t count;
+    struct sll_cache_bin batches[SLL_DEPOT_BATCHES];
+} sll_depot[SLL_CACHE_CLASSES];
+static pthread_mutex_t sll_depot_lock = PTHREAD_MUTEX_INITIALIZER;
+static pthread_key_t sll_cache_key;
+static pthread_once_t sll_cache_key_once = PTHREAD_ONCE_INIT;
+
+
+#define SLL_MAX_ALIGNMENT ((size_t)4096)
+
+
+// Gaps between consecutive nodes are capped here in sllist_stats(): a jump that far costs a cache
+// and a TLB miss whatever its length, and a few jumps between distant mappings would swamp the mean.
+#define SLL_STATS_MAX_GAP ((uintptr_t)1 << 20)
+
+
+#if (defined(SLLIST_INSTRUMENT) || defined(SLLIST_USDT)) && !defined(__GNUC__) && !defined(__clang__)
+#error "SLLIST_INSTRUMENT and SLLIST_USDT require GCC or Clang"
+#endif
+
+
+// Nodes walked and blocks allocated by this thread, read as their growth across an operation by
+// the counters and the tracepoints below.
+#if defined(SLLIST_INSTRUMENT) || defined(SLLIST_USDT)
+static _Thread_local struct {
+    uint64_t nodes;
+    uint64_t allocations;
+} sll_op_tally;
+#define SLL_COUNT_NODES(n) (sll_op_tally.nodes += (n))
+#define SLL_COUNT_ALLOCATION() (sll_op_tally.allocations++)
+#else
+#define SLL_COUNT_NODES(n) ((void)0)
+#define SLL_COUNT_ALLOCATION() ((void)0)
+#endif
+
+
+// Operation counters (see sllist_op_stats_get) are compiled in only with -DSLLIST_INSTRUMENT. Each
+// instrumented operation opens an SLL_OP_SCOPE, which is closed by the compiler's cleanup attribute
+// on every return path.
+#ifdef SLLIST_INSTRUMENT
+struct sll_op_scope {
+    sllist_op op;
+    uint64_t start_ns;
+    uint64_t nodes;
+    uint64_t allocations;
+};
+static sllist_op_stats sll_op_table[SLLIST_OP_COUNT];
+#define SLL_OP_SCOPE(op) \
+    struct sll_op_scope sll_scope __attribute__((cleanup(sll_op_end), unused)) = sll_op_begin(op)
+#else
+#define SLL_OP_SCOPE(op) ((void)0)
+#endif
+
+
+// Static tracepoints are compiled in only with -DSLLIST_USDT. Every public function fires
+// sllist:entry(function, handle, index) when called and sllist:exit(function, handle, nodes walked)
+// on every return path; handle is the list, snapshot or iterator operated on (NULL for creators)
+// and index is 0 for functions that take none. An inactive probe is a single nop. Library code never
+// calls a probed public function: it uses the static helper behind it, so probes do not nest.
+#ifdef SLLIST_USDT
+struct sll_probe_scope {
+    const char* function;
+    uintptr_t handle; // Kept as an integer: free_sllist() fires its exit probe after freeing the list
+    uint64_t nodes;
+};
+#define SLL_PROBE_SCOPE(handle, index) \
+    struct sll_probe_scope sll_probe __attribute__((cleanup(sll_probe_exit), unused)) = \
+        sll_probe_entry(__func__, (handle), (index))
+#else
+#define SLL_PROBE_SCOPE(handle, index) ((void)0)
+#endif
+
+
+static const char* const sll_op_names[SLLIST_OP_COUNT] = {
+    "insert_front", "insert_end", "insert_at_index", "free_at_front", "free_at_end", "free_at_index", "sll_len"
+};
+
+
+#define SLL_FILE_MAGIC "SLLS"
+#define SLL_FILE_VERSION 1u
+
+
+/**
+ * @brief On-disk header written by sllist_save().
+ */
+struct sll_file_header {
+    char magic[4];
+    uint32_t version;
+    uint64_t data_size;
+    uint64_t count;
+};
+
+
+/**
+ * @brief Rounds `size` up to a multiple of `align` (a power of two).
+ */
+static size_t sll_align_up(size_t size, size_t align) {
+    return (size + align - 1) & ~(align - 1);
+}
+
+
+#ifdef SLLIST_USDT
+/**
+ * @brief Fires the entry tracepoint of a public function and opens the scope of its exit tracepoint.
+ */
+static struct sll_probe_scope sll_probe_entry(const char* function, const void* handle, size_t index) {
+    STAP_PROBE3(sllist, entry, function, handle, index);
+    struct sll_probe_scope scope = { function, (uintptr_t)handle, sll_op_tally.nodes };
+    return scope;
+}
+
+
+/**
+ * @brief Fires the exit tracepoint of a public function.
+ */
+static void sll_probe_exit(struct sll_probe_scope* scope) {
+    uint64_t nodes = sll_op_tally.nodes - scope->nodes;
+    STAP_PROBE3(sllist, exit, scope->function, scope->handle, nodes);
+}
+#endif
+
+
+#ifdef SLLIST_INSTRUMENT
+/**
+ * @brief Returns a monotonic timestamp in nanoseconds.
+ */
+static uint64_t sll_now_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000u + (uint64_t)ts.tv_nsec;
+}
+
+
+/**
+ * @brief Opens the scope of an instrumented operation.
+ */
+static struct sll_op_scope sll_op_begin(sllist_op op) {
+    struct sll_op_scope scope = { op, 0, sll_op_tally.nodes, sll_op_tally.allocations };
+    scope.start_ns = sll_now_ns();
+    return scope;
+}
+
+
+/**
+ * @brief Closes the scope of an instrumented operation and adds it to the operation's counters.
+ */
+static void sll_op_end(struct sll_op_scope* scope) {
+    uint64_t elapsed = sll_now_ns() - scope->start_ns;
+    size_t bucket = elapsed == 0 ? 0 : (size_t)(63 - __builtin_clzll(elapsed));
+    if (bucket >= SLLIST_LATENCY_BUCKETS) {
+        bucket = SLLIST_LATENCY_BUCKETS - 1;
+    }
+
+    sllist_op_stats* stats = &sll_op_table[scope->op];
+    __atomic_add_fetch(&stats->calls, 1, __ATOMIC_RELAXED);
+    __atomic_add_fetch(&stats->nodes_traversed, sll_op_tally.nodes - scope->nodes, __ATOMIC_RELAXED);
+    __atomic_add_fetch(&stats->allocations, sll_op_tally.allocations - scope->allocations, __ATOMIC_RELAXED);
+    __atomic_add_fetch(&stats->latency[bucket], 1, __ATOMIC_RELAXED);
+}
+#endif
+
+
+/**
+ * @brief Frees every block of a chain.
+ */
+static void sll_chain_free(void* head) {
+    while (head != NULL) {
+        void* next = *(void**)head;
+        free(head);
+        head = next;
+    }
+}
+
+
+/**
+ * @brief Stores a chain of free blocks in the depot, or frees it if the depot is full.
+ */
+static void sll_depot_put(size_t cls, struct sll_cache_bin batch) {
+    pthread_mutex_lock(&sll_depot_lock);
+    int stored = sll_depot[cls].count < SLL_DEPOT_BATCHES;
+    if (stored) {
+        sll_depot[cls].batches[sll_depot[cls].count++] = batch;
+    }
+    pthread_mutex_unlock(&sll_depot_lock);
+    if (!stored) {
+        sll_chain_free(batch.head);
+    }
+}
+
+
+/**
+ * @brief Hands the blocks cached by an exiting thread over to the depot.
+ */
+static void sll_cache_flush(void* unused) {
+    (void)unused;
+    for (size_t cls = 0; cls < SLL_CACHE_CLASSES; cls++) {
+        if (sll_cache[cls].head != NULL) {
+            sll_depot_put(cls, sll_cache[cls]);
+            sll_cache[cls].head = NULL;
+            sll_cache[cls].count = 0;
+        }
+    }
+    sll_cache_registered = 0;
+}
+
+
+/**
+ * @brief Before fork(): takes the library's process-wide locks so the child inherits them in a consistent state.
+ */
+static void sll_fork_prepare(void) {
+    pthread_mutex_lock(&sll_reclaimer.lock);
+    pthread_mutex_lock(&sll_depot_lock);
+}
+
+
+/**
+ * @brief After fork(), in the parent: releases the locks taken by sll_fork_prepare().
+ */
+static void sll_fork_parent(void) {
+    pthread_mutex_unlock(&sll_depot_lock);
+    pthread_mutex_unlock(&sll_reclaimer.lock);
+}
+
+
+/**
+ * @brief After fork(), in the child: resets the locks and marks the reclaimer thread, which did not survive, as stopped.
+ *
+ * Lists still queued are kept and freed by a new reclaimer started on the next sllist_free_async() or
+ * sllist_reclaim_wait(); a batch the old thread was freeing at the time of the fork is leaked in the child.
+ */
+static void sll_fork_child(void) {
+    pthread_mutex_init(&sll_depot_lock, NULL);
+    pthread_mutex_init(&sll_reclaimer.lock, NULL);
+    pthread_cond_init(&sll_reclaimer.work, NULL);
+    pthread_cond_init(&sll_reclaimer.idle, NULL);
+    sll_reclaimer.busy = 0;
+    sll_reclaimer.started = 0;
+}
+
+
+static void sll_fork_init(void) {
+    pthread_atfork(sll_fork_prepare, sll_fork_parent, sll_fork_child);
+}
+
+
+static void sll_cache_key_init(void) {
+    pthread_key_create(&sll_cache_key, sll_cache_flush);
+}
+
+
+/**
+ * @brief Arranges for this thread's cache to be flushed to the depot when the thread exits.
+ *
+ * Called before a thread first stores blocks in its cache, whether freed by it or refilled from the
+ * depot, and before it first takes the depot lock, which the fork handlers must know about.
+ */
+static void sll_cache_register(void) {
+    if (sll_cache_registered) {
+        return;
+    }
+    pthread_once(&sll_fork_once, sll_fork_init);
+    // Registering a value makes the key's destructor run when this thread exits.
+    pthread_once(&sll_cache_key_once, sll_cache_key_init);
+    pthread_setspecific(sll_cache_key, &sll_cache_registered);
+    sll_cache_registered = 1;
+}
+
+
+/**
+ * @brief Returns the block size of a cache size class: the largest size the class holds.
+ */
+static size_t sll_class_size(size_t cls) {
+    return (cls + 1) * SLL_CACHE_GRANULE + sizeof(size_t);
+}
+
+
+/**
+ * @brief Returns the size class of a block of `size` bytes, or SLL_CACHE_CLASSES if it is not cached.
+ */
+static size_t sll_size_class(size_t size) {
+    if (size > sll_class_size(SLL_CACHE_CLASSES - 1)) {
+        return SLL_CACHE_CLASSES;
+    }
+    return size <= sll_class_size(0) ? 0 : (size - sizeof(size_t) - 1) / SLL_CACHE_GRANULE;
+}
+
+
+/**
+ * @brief Default allocator: malloc() behind per-thread caches of recently freed small blocks.
+ *
+ * Lists that churn nodes and payloads recycle them within the thread without touching malloc's
+ * shared state; a thread with an empty cache takes a whole batch from the depot at once.
+ */
+static void* sll_default_alloc(void* ctx, size_t size) {
+    (void)ctx;
+    size_t cls = sll_size_class(size);
+    if (cls == SLL_CACHE_CLASSES) {
+        return malloc(size);
+    }
+
+    struct sll_cache_bin* bin = &sll_cache[cls];
+    if (bin->head == NULL) {
+        sll_cache_register(); // The refilled batch must not be lost when this thread exits
+        pthread_mutex_lock(&sll_depot_lock);
+        if (sll_depot[cls].count > 0) {
+            *bin = sll_depot[cls].batches[--sll_depot[cls].count];
+        }
+        pthread_mutex_unlock(&sll_depot_lock);
+    }
+    if (bin->head == NULL) {
+        return malloc(sll_class_size(cls)); // Room for any size in the class
+    }
+    void* block = bin->head;
+    bin->head = *(void**)block;
+    bin->count--;
+    return block;
+}
+
+
+/**
+ * @brief Returns a block to this thread's cache, moving a batch to the depot when the cache grows too large.
+ */
+static void sll_default_free(void* ctx, void* ptr, size_t size) {
+    (void)ctx;
+    size_t cls = sll_size_class(size);
+    if (cls == SLL_CACHE_CLASSES) {
+        free(ptr);
+        return;
+    }
+
+    sll_cache_register();
+    struct sll_cache_bin* bin = &sll_cache[cls];
+    *(void**)ptr = bin->head;
+    bin->head = ptr;
+    bin->count++;
+    if (bin->count < 2 * SLL_CACHE_BATCH) {
+        return;
+    }
+
+    // Keep one batch for this thread and give the other to the depot.
+    struct sll_cache_bin batch = { bin->head, SLL_CACHE_BATCH };
+    void* last = bin->head;
+    for (size_t i = 1; i < SLL_CACHE_BATCH; i++) {
+        last = *(void**)last;
+    }
+    bin->head = *(void**)last;
+    bin->count -= SLL_CACHE_BATCH;
+    *(void**)last = NULL;
+    sll_depot_put(cls, batch);
+}
+
+
+/**
+ * @brief Allocates `size` bytes with the list's allocator.
+ */
+static void* sll_alloc(const sllist* list, size_t size) {
+    SLL_COUNT_ALLOCATION();
+    return list->allocator.alloc(list->allocator.ctx, size);
+}
+
+
+/**
+ * @brief Returns a block of `size` bytes obtained from sll_alloc() to the list's allocator.
+ */
+static void sll_free(const sllist* list, void* ptr, size_t size) {
+    list->allocator.free(list->allocator.ctx, ptr, size);
+}
+
+
+/**
+ * @brief Returns the size reserved for each payload: data_size rounded up to the list's alignment.
+ *
+ * Rounding keeps every payload of a slab aligned, and keeps separately allocated payloads from
+ * sharing an alignment block (a cache line, for 64-byte alignment) with anything else.
+ */
+static size_t sll_payload_stride(const sllist* list) {
+    return list->alignment > 1 ? sll_align_up(list->data_size, list->alignment) : list->data_size;
+}
+
+
+/**
+ * @brief Returns non-zero if payloads need more alignment than the allocator guarantees.
+ */
+static int sll_overaligned(const sllist* list) {
+    return list->alignment > _Alignof(max_align_t);
+}
+
+
+/**
+ * @brief Returns non-zero if slab payloads are packed back to back, exactly like an array of elements.
+ */
+static int sll_payloads_packed(const sllist* list) {
+    return !SLL_INLINE_DATA(list) && sll_payload_stride(list) == list->data_size;
+}
+
+
+/**
+ * @brief Returns the size of the block allocated for one separately allocated payload.
+ *
+ * Over-aligned payloads get room to slide up to the next aligned address, preceded by a pointer
+ * to the start of the block.
+ */
+static size_t sll_payload_block_size(const sllist* list) {
+    size_t stride = sll_payload_stride(list);
+    return sll_overaligned(list) ? stride + sizeof(void*) + list->alignment - 1 : stride;
+}
+
+
+/**
+ * @brief Estimates the bytes an allocation of `size` bytes costs beyond `size` itself.
+ *
+ * Models a typical malloc(): an 8-byte header, 16-byte rounding and a 32-byte minimum block. The
+ * default allocator first rounds small sizes up to its cache size class.
+ */
+static size_t sll_block_slack(const sllist* list, size_t size) {
+    size_t block = size;
+    if (list->allocator.alloc == sll_default_alloc && sll_size_class(size) < SLL_CACHE_CLASSES) {
+        block = sll_class_size(sll_size_class(size));
+    }
+    size_t chunk = sll_align_up(block + sizeof(size_t), 16);
+    return (chunk < 32 ? 32 : chunk) - size;
+}
+
+
+/**
+ * @brief Allocates storage for one payload, aligned as the list requires.
+ */
+static void* sll_payload_alloc(const sllist* list) {
+    unsigned char* block = (unsigned char*)sll_alloc(list, sll_payload_block_size(list));
+    if (!block || !sll_overaligned(list)) {
+        return block;
+    }
+    void** payload = (void**)sll_align_up((uintptr_t)block + sizeof(void*), list->alignment);
+    payload[-1] = block;
+    return payload;
+}
+
+
+/**
+ * @brief Frees storage obtained from sll_payload_alloc().
+ */
+static void sll_payload_free(const sllist* list, void* payload) {
+    void* block = sll_overaligned(list) ? ((void**)payload)[-1] : payload;
+    sll_free(list, block, sll_payload_block_size(list));
+}
+
+
+/**
+ * @brief Applies a policy binding `[addr, addr + len)` to `numa_node`; with MPOL_MF_MOVE in `flags`,
+ * pages already in place elsewhere are migrated. `addr` must be page-aligned.
+ *
+ * @return 0 on success, or -1 on failure (including on systems without NUMA support).
+ */
+static int sll_numa_bind(void* addr, size_t len, int numa_node, unsigned flags) {
+#ifdef __linux__
+    unsigned long mask[SLL_NUMA_MAX_NODES / (8 * sizeof(unsigned long))] = { 0 };
+    size_t bits = 8 * sizeof(unsigned long);
+    mask[numa_node / bits] = 1UL << (numa_node % bits);
+    // The kernel reads maxnode - 1 bits of the mask.
+    return syscall(SYS_mbind, addr, len, MPOL_BIND, mask, SLL_NUMA_MAX_NODES + 1, flags) == 0 ? 0 : -1;
+#else
+    (void)addr;
+    (void)len;
+    (void)numa_node;
+    (void)flags;
+    return -1;
+#endif
+}
+
+
+/**
+ * @brief Returns the NUMA node the calling thread is running on, or -1 if it cannot be determined.
+ */
+static int sll_numa_current_node(void) {
+#ifdef __linux__
+    unsigned cpu, node;
+    if (syscall(SYS_getcpu, &cpu, &node, NULL) == 0) {
+        return (int)node;
+    }
+#endif
+    return -1;
+}
+
+
+/**
+ * @brief Returns non-zero if the arena's chunks are mapped directly rather than obtained from malloc().
+ */
+static int sll_arena_mapped(const struct sll_arena* arena) {
+#ifdef __linux__
+    return arena->numa_node >= 0 || arena->huge_pages;
+#else
+    (void)arena;
+    return 0;
+#endif
+}
+
+
+#ifdef __linux__
+/**
+ * @brief Maps `*total` bytes of anonymous memory.
+ *
+ * With `huge_pages`, `*total` is rounded up to whole huge pages and the mapping is aligned to a
+ * huge page boundary, so the kernel can back all of it with transparent huge pages.
+ */
+static void* sll_chunk_map(size_t* total, int huge_pages) {
+    if (!huge_pages) {
+        void* block = mmap(NULL, *total, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        return block == MAP_FAILED ? NULL : block;
+    }
+
+    if (*total > SIZE_MAX - 2 * SLL_HUGE_PAGE_SIZE) {
+        return NULL; // Size overflow
+    }
+    size_t size = sll_align_up(*total, SLL_HUGE_PAGE_SIZE);
+    // Over-map by one huge page, then unmap the misaligned head and the unused tail.
+    size_t span = size + SLL_HUGE_PAGE_SIZE;
+    void* block = mmap(NULL, span, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (block == MAP_FAILED) {
+        return NULL;
+    }
+    uintptr_t start = (uintptr_t)block;
+    uintptr_t aligned = sll_align_up(start, SLL_HUGE_PAGE_SIZE);
+    if (aligned > start) {
+        munmap(block, aligned - start);
+    }
+    if (aligned + size < start + span) {
+        munmap((void*)(aligned + size), start + span - (aligned + size));
+    }
+#ifdef MADV_HUGEPAGE
+    madvise((void*)aligned, size, MADV_HUGEPAGE); // Advisory: regular pages still work if this fails
+#endif
+    *total = size;
+    return (void*)aligned;
+}
+#endif
+
+
+/**
+ * @brief Allocates a chunk of at least `size` usable bytes for an arena and makes it the current one.
+ *
+ * Chunks of a NUMA arena are bound to its node before any page is touched; chunks of a huge-page
+ * arena span whole, aligned huge pages.
+ */
+static struct sll_arena_chunk* sll_arena_chunk_alloc(struct sll_arena* arena, size_t size) {
+    if (size > SIZE_MAX - sizeof(struct sll_arena_chunk)) {
+        return NULL; // Size overflow
+    }
+    size_t total = sizeof(struct sll_arena_chunk) + size;
+
+    struct sll_arena_chunk* chunk;
+    if (!sll_arena_mapped(arena)) {
+        chunk = (struct sll_arena_chunk*)malloc(total);
+    } else {
+#ifdef __linux__
+        chunk = (struct sll_arena_chunk*)sll_chunk_map(&total, arena->huge_pages);
+        if (chunk != NULL && arena->numa_node >= 0 && sll_numa_bind(chunk, total, arena->numa_node, 0) != 0) {
+            munmap(chunk, total);
+            chunk = NULL; // Node not usable
+        }
+#else
+        chunk = NULL;
+#endif
+    }
+    if (!chunk) {
+        return NULL; // Memory allocation failed
+    }
+
+    chunk->next = arena->chunks;
+    chunk->size = total - sizeof(struct sll_arena_chunk); // Mappings may be rounded up
+    chunk->used = 0;
+    arena->chunks = chunk;
+    if (arena->next_chunk_size < SLL_ARENA_MAX_CHUNK) {
+        arena->next_chunk_size *= 2;
+    }
+    return chunk;
+}
+
+
+/**
+ * @brief Returns a chunk to wherever sll_arena_chunk_alloc() got it from.
+ */
+static void sll_arena_chunk_free(struct sll_arena* arena, struct sll_arena_chunk* chunk) {
+#ifdef __linux__
+    if (sll_arena_mapped(arena)) {
+        munmap(chunk, sizeof(struct sll_arena_chunk) + chunk->size);
+        return;
+    }
+#endif
+    (void)arena;
+    free(chunk);
+}
+
+
+/**
+ * @brief Bump-allocates `size` bytes from an arena, adding a chunk when the current one is full.
+ *
+ * An object's alignment always divides its size, so a block is aligned to the largest power of two
+ * dividing `size` (capped at max_align_t) rather than always to max_align_t. This keeps nodes tightly packed.
+ */
+static void* sll_arena_alloc(void* ctx, size_t size) {
+    struct sll_arena* arena = (struct sll_arena*)ctx;
+    size_t align = size & (~size + 1);
+    if (align == 0 || align > _Alignof(max_align_t)) {
+        align = _Alignof(max_align_t);
+    }
+
+    struct sll_arena_chunk* chunk = arena->chunks;
+    if (chunk != NULL) {
+        size_t offset = sll_align_up(chunk->used, align);
+        if (offset <= chunk->size && size <= chunk->size - offset) {
+            chunk->used = offset + size;
+            return chunk->data + offset;
+        }
+    }
+
+    size_t chunk_size = arena->next_chunk_size;
+    if (size > chunk_size) {
+        chunk_size = size; // Oversized request: give it a chunk of its own
+    }
+    chunk = sll_arena_chunk_alloc(arena, chunk_size);
+    if (!chunk) {
+        return NULL; // Memory allocation failed
+    }
+    chunk->used = size;
+    return chunk->data;
+}
+
+
+/**
+ * @brief Individual frees are no-ops in an arena; memory is reclaimed all at once.
+ */
+static void sll_arena_free(void* ctx, void* ptr, size_t size) {
+    (void)ctx;
+    (void)ptr;
+    (void)size;
+}
+
+
+/**
+ * @brief Returns non-zero if the list was created by sllist_create_arena().
+ */
+static int sll_is_arena(const sllist* list) {
+    return list->allocator.alloc == sll_arena_alloc && list->allocator.ctx == (const void*)list;
+}
+
+
+/**
+ * @brief Frees the chunks of an arena, keeping the newest (and largest) one for reuse if `keep` is set.
+ */
+static void sll_arena_reset(struct sll_arena* arena, int keep) {
+    struct sll_arena_chunk* chunk = arena->chunks;
+    if (keep && chunk != NULL) {
+        chunk->used = 0;
+        chunk = chunk->next;
+        arena->chunks->next = NULL;
+    } else {
+        arena->chunks = NULL;
+    }
+    while (chunk != NULL) {
+        struct sll_arena_chunk* next = chunk->next;
+        sll_arena_chunk_free(arena, chunk);
+        chunk = next;
+    }
+}
+
+
+/**
+ * @brief Creates an empty arena list; chunks are bound to `numa_node` unless it is negative, and
+ * backed by huge pages if `huge_pages` is set.
+ */
+static sllist* sll_arena_create(size_t data_size, int numa_node, int huge_pages) {
+    struct sll_arena* arena = (struct sll_arena*)malloc(sizeof(struct sll_arena));
+    if (!arena) {
+        return NULL; // Memory allocation failed
+    }
+    arena->chunks = NULL;
+    arena->next_chunk_size = huge_pages ? SLL_HUGE_PAGE_SIZE - sizeof(struct sll_arena_chunk) : SLL_ARENA_FIRST_CHUNK;
+    arena->numa_node = numa_node;
+    arena->huge_pages = huge_pages;
+
+    sllist* list = &arena->list;
+    list->head = NULL;
+    list->data_size = data_size;
+    list->slab = NULL;
+    list->allocator.alloc = sll_arena_alloc;
+    list->allocator.free = sll_arena_free;
+    list->allocator.ctx = arena;
+    list->alignment = 0;
+    list->slow_op_hook = NULL;
+    list->slow_op_threshold = 0;
+    list->slow_op_tag = NULL;
+    list->shared = 0;
+    return list;
+}
+
+
+/**
+ * @brief Body of sllist_create_with_allocator(), shared by every function that makes a heap list.
+ */
+static sllist* sll_create(size_t data_size, const sllist_allocator* allocator) {
+    sllist_allocator chosen = { sll_default_alloc, sll_default_free, NULL };
+    if (allocator != NULL) {
+        if (!allocator->alloc || !allocator->free) {
+            return NULL; // Invalid parameters
+        }
+        chosen = *allocator;
+    }
+
+    sllist* list = (sllist*)chosen.alloc(chosen.ctx, sizeof(sllist));
+    if (!list) {
+        return NULL; // Memory allocation failed
+    }
+    list->head = NULL;
+    list->data_size = data_size;
+    list->slab = NULL;
+    list->allocator = chosen;
+    list->alignment = 0;
+    list->slow_op_hook = NULL;
+    list->slow_op_threshold = 0;
+    list->slow_op_tag = NULL;
+    list->shared = 0;
+    return list;
+}
+
+
+/**
+ * @brief Returns an empty list that stores its elements the way `list` does: in a fresh arena if
+ * `list` is an arena list, otherwise with the same allocator.
+ */
+static sllist* sll_create_like(sllist* list) {
+    if (sll_is_arena(list)) {
+        const struct sll_arena* arena = (const struct sll_arena*)list->allocator.ctx;
+        sllist* like = sll_arena_create(list->data_size, arena->numa_node, arena->huge_pages);
+        if (like != NULL) {
+            like->alignment = list->alignment;
+        }
+        return like;
+    }
+    sllist* like = sll_create(list->data_size, &list->allocator);
+    if (like != NULL) {
+        like->alignment = list->alignment;
+    }
+    return like;
+}
+
+
+/**
+ * @brief Returns the offset of the payload slots in a slab of `count` nodes.
+ */
+static size_t sll_slab_payload_offset(size_t count) {
+    return sll_align_up(sizeof(struct sll_slab) + count * sizeof(sll_node), _Alignof(max_align_t));
+}
+
+
+/**
+ * @brief Returns the total size of a slab of `count` nodes for `list`, or 0 if it overflows.
+ *
+ * The size is a multiple of max_align_t's alignment: an arena aligns each block by its size, and the
+ * slab header and payload slots need max_align_t alignment whatever the payload size.
+ */
+static size_t sll_slab_size(const sllist* list, size_t count) {
+    if (count == 0 || count > (SIZE_MAX - sizeof(struct sll_slab)) / sizeof(sll_node)) {
+        return 0; // Nothing to allocate or size overflow
+    }
+    if (SLL_INLINE_DATA(list)) {
+        return sll_slab_payload_offset(count); // Inline payloads need no slots
+    }
+    // Over-aligned payloads may have to start up to alignment - max_align_t bytes later.
+    size_t payload_offset = sll_slab_payload_offset(count);
+    if (sll_overaligned(list)) {
+        payload_offset += list->alignment - _Alignof(max_align_t);
+    }
+    size_t stride = sll_payload_stride(list);
+    if (stride != 0 && count > (SIZE_MAX - payload_offset - _Alignof(max_align_t)) / stride) {
+        return 0; // Size overflow
+    }
+    return sll_align_up(payload_offset + count * stride, _Alignof(max_align_t));
+}
+
+
+/**
+ * @brief Allocates a slab of `count` nodes with payload storage, linked in order.
+ *
+ * Node i points at payload slot i and at node i + 1; the last node's next is NULL.
+ * Payloads are stored back to back, which keeps every slot aligned like an array of the element type,
+ * with a stride rounded up to the list's alignment if it has one.
+ * Inline payloads need no slots, so the slab then holds only the nodes.
+ */
+static struct sll_slab* sll_slab_alloc(const sllist* list, size_t count) {
+    size_t size = sll_slab_size(list, count);
+    if (size == 0) {
+        return NULL; // Nothing to allocate or size overflow
+    }
+
+    struct sll_slab* slab = (struct sll_slab*)sll_alloc(list, size);
+    if (!slab) {
+        return NULL; // Memory allocation failed
+    }
+    slab->refs = 1;
+    slab->count = count;
+
+    int inline_data = SLL_INLINE_DATA(list);
+    size_t stride = sll_payload_stride(list);
+    unsigned char* payload = (unsigned char*)slab + sll_slab_payload_offset(count);
+    if (sll_overaligned(list)) {
+        payload = (unsigned char*)sll_align_up((uintptr_t)payload, list->alignment);
+    }
+    for (size_t i = 0; i < count; i++) {
+        slab->nodes[i].data = inline_data ? NULL : payload + i * stride;
+        slab->nodes[i].next = &slab->nodes[i + 1];
+        slab->nodes[i].refs = 1;
+    }
+    slab->nodes[count - 1].next = NULL;
+    return slab;
+}
+
+
+/**
+ * @brief Returns a pointer to the payload of a node of `list`.
+ */
+static void* sll_payload(const sllist* list, sll_node* node) {
+    return SLL_INLINE_DATA(list) ? (void*)&node->data : node->data;
+}
+
+
+/**
+ * @brief Copies `count` contiguous payloads from `src` into the nodes of a fresh slab, in order.
+ */
+static void sll_slab_fill(const sllist* list, struct sll_slab* slab, const void* src, size_t count) {
+    if (sll_payloads_packed(list)) {
+        memcpy(slab->nodes[0].data, src, count * list->data_size); // Slots are contiguous
+        return;
+    }
+    const unsigned char* from = (const unsigned char*)src;
+    for (size_t i = 0; i < count; i++) {
+        memcpy(sll_payload(list, &slab->nodes[i]), from, list->data_size);
+        from += list->data_size;
+    }
+}
+
+
+/**
+ * @brief Drops one list's reference to a slab, freeing it after the last one.
+ */
+static void sll_slab_release(const sllist* list, struct sll_slab* slab) {
+    if (slab != NULL && (!list->shared || SLL_REF_DEC(slab) == 0)) {
+        sll_free(list, slab, sll_slab_size(list, slab->count));
+    }
+}
+
+
+/**
+ * @brief Returns non-zero if `node` lives inside the list's slab.
+ */
+static int sll_in_slab(const sllist* list, const sll_node* node) {
+    const struct sll_slab* slab = list->slab;
+    if (slab == NULL) {
+        return 0;
+    }
+    uintptr_t addr = (uintptr_t)node;
+    uintptr_t first = (uintptr_t)&slab->nodes[0];
+    return addr >= first && addr < first + slab->count * sizeof(sll_node);
+}
+
+
+/**
+ * @brief Allocates a node holding a copy of `data`, with one reference and a NULL next pointer.
+ *
+ * Payloads no larger than a pointer are stored in the data field itself, saving an allocation.
+ */
+static sll_node* sll_node_alloc(sllist* list, void* data) {
+    sll_node* new_node = (sll_node*)sll_alloc(list, sizeof(sll_node));
+    if (!new_node) {
+        return NULL; // Memory allocation failed
+    }
+
+    if (SLL_INLINE_DATA(list)) {
+        new_node->data = NULL;
+        memcpy(&new_node->data, data, list->data_size);
+        new_node->next = NULL;
+        new_node->refs = 1;
+        return new_node;
+    }
+
+    new_node->data = sll_payload_alloc(list);
+    if (!new_node->data) {
+        sll_free(list, new_node, sizeof(sll_node));
+        return NULL; // Memory allocation failed
+    }
+    memcpy(new_node->data, data, list->data_size);
+    new_node->next = NULL;
+    new_node->refs = 1;
+    return new_node;
+}
+
+
+/**
+ * @brief Frees a node and its data. Slab nodes are reclaimed together with the slab.
+ */
+static void sll_node_free(sllist* list, sll_node* node) {
+    if (sll_in_slab(list, node)) {
+        return;
+    }
+    if (!SLL_INLINE_DATA(list)) {
+        sll_payload_free(list, node->data);
+    }
+    sll_free(list, node, sizeof(sll_node));
+}
+
+
+/**
+ * @brief Drops one reference to `node`; a node left unreferenced is freed and drops its reference to the next one.
+ *
+ * Nodes of a list that was never cloned have exactly one reference, so the whole chain is freed
+ * without touching the counts.
+ */
+static void sll_node_release(sllist* list, sll_node* node) {
+    if (!list->shared) {
+        while (node != NULL) {
+            sll_node* next_node = node->next;
+            sll_node_free(list, node);
+            node = next_node;
+        }
+        return;
+    }
+    while (node != NULL && SLL_REF_DEC(node) == 0) {
+        sll_node* next_node = node->next;
+        sll_node_free(list, node);
+        node = next_node;
+    }
+}
+
+
+/**
+ * @brief Returns the node `*link` points to, first replacing it with a private copy if a clone shares it.
+ *
+ * Copying a shared node adds a reference to its successor, so a walk that continues past it copies the
+ * successor too: exactly the prefix leading up to a modification is duplicated, the rest stays shared.
+ *
+ * @return The node now owned by this list alone, or NULL if the copy could not be allocated.
+ */
+static sll_node* sll_node_private(sllist* list, sll_node** link) {
+    sll_node* node = *link;
+    SLL_COUNT_NODES(1);
+    if (!list->shared || !SLL_REF_SHARED(node)) {
+        return node;
+    }
+
+    sll_node* copy = sll_node_alloc(list, sll_payload(list, node));
+    if (!copy) {
+        return NULL; // Memory allocation failed
+    }
+    copy->next = node->next;
+    if (copy->next != NULL) {
+        SLL_REF_INC(copy->next);
+    }
+    *link = copy;
+    sll_node_release(list, node);
+    return copy;
+}
+
+
+/**
+ * @brief Removes the node `*link` points to; `*link` must be owned by this list.
+ */
+static void sll_unlink(sllist* list, sll_node** link) {
+    sll_node* victim = *link;
+    *link = victim->next;
+    if (list->shared && SLL_REF_SHARED(victim)) {
+        // A clone still uses the node, so this list takes its own reference to the successor.
+        if (victim->next != NULL) {
+            SLL_REF_INC(victim->next);
+        }
+        sll_node_release(list, victim);
+    } else {
+        sll_node_free(list, victim); // Its reference to the successor now belongs to *link
+    }
+}
+
+
+/**
+ * @brief Counts the nodes of the list without counting the call as an operation.
+ *
+ * Used wherever the library needs the length for its own purposes, so that sllist_op_stats and
+ * slow-operation hooks only see the sll_len() calls made by the caller.
+ */
+static size_t sll_count(const sllist* list) {
+    size_t length = 0;
+    for (const sll_node* node = list->head; node != NULL; node = node->next) {
+        length++;
+    }
+    return length;
+}
+
+
+/**
+ * @brief Calls the list's slow-operation hook if `op` walked more nodes than its threshold.
+ */
+static void sll_check_walk(sllist* list, sllist_op op, size_t walked) {
+    static _Thread_local int in_hook; // Operations the hook itself performs are not reported
+    if (list->slow_op_hook == NULL || walked <= list->slow_op_threshold || in_hook) {
+        return;
+    }
+    size_t length = sll_count(list);
+    in_hook = 1;
+    list->slow_op_hook(list, op, walked, length, list->slow_op_tag);
+    in_hook = 0;
+}
+
+
+/**
+ * @brief Body of free_sllist(), also used to discard lists the library built or queued itself.
+ */
+static void sll_destroy(sllist* list) {
+    if (sll_is_arena(list)) {
+        struct sll_arena* arena = (struct sll_arena*)list->allocator.ctx;
+        sll_arena_reset(arena, 0); // Every node lives in the arena: no need to walk the list
+        free(arena);
+        return;
+    }
+    sll_node_release(list, list->head); // Stops at the first node a clone still uses
+    sll_slab_release(list, list->slab);
+    sll_free(list, list, sizeof(sllist));
+}
+
+
+/**
+ * @brief Body of sllist_iter_begin(). Library code iterates through these helpers so that only the
+ * caller's own calls fire the iterator tracepoints.
+ */
+static sllist_iter sll_iter_begin(const sllist* list, size_t prefetch_distance) {
+    sllist_iter it = { NULL, NULL, 0 };
+    if (!list || list->head == NULL) {
+        return it;
+    }
+
+    it.inline_data = SLL_INLINE_DATA(list);
+    it.current = list->head;
+    if (prefetch_distance == 0) {
+        return it; // Prefetching disabled
+    }
+
+    // Walk the lookahead cursor out to the requested distance once; from then on
+    // each step of the iterator moves it by a single node.
+    it.ahead = list->head;
+    for (size_t i = 0; i < prefetch_distance && it.ahead != NULL; i++) {
+        if (!it.inline_data) {
+            SLL_PREFETCH(it.ahead->data);
+        }
+        it.ahead = it.ahead->next;
+        if (it.ahead != NULL) {
+            SLL_PREFETCH(it.ahead);
+        }
+    }
+    return it;
+}
+
+
+/**
+ * @brief Body of sllist_iter_next().
+ */
+static void sll_iter_next(sllist_iter* it) {
+    if (!it || it->current == NULL) {
+        return; // Iterator exhausted
+    }
+
+    if (it->ahead != NULL) {
+        // The lookahead node was prefetched on the previous step, so reading its
+        // fields here is cheap; its payload and successor are requested now.
+        if (!it->inline_data) {
+            SLL_PREFETCH(it->ahead->data);
+        }
+        it->ahead = it->ahead->next;
+        if (it->ahead != NULL) {
+            SLL_PREFETCH(it->ahead);
+        }
+    }
+    it->current = it->current->next;
+    SLL_COUNT_NODES(1);
+}
+
+
+/**
+ * @brief Body of sllist_iter_get().
+ */
+static void* sll_iter_get(const sllist_iter* it) {
+    if (!it || it->current == NULL) {
+        return NULL; // Iterator exhausted
+    }
+    return it->inline_data ? (void*)&it->current->data : it->current->data;
+}
+
+
+/**
+ * @brief Allocates a slab for `owner` holding a copy of every element of a non-empty list, in list order.
+ *
+ * `owner` supplies the allocator and may be `list` itself; both lists have the same data size.
+ */
+static struct sll_slab* sll_slab_copy(const sllist* owner, sllist* list) {
+    struct sll_slab* slab = sll_slab_alloc(owner, sll_count(list));
+    if (!slab) {
+        return NULL; // Memory allocation failed
+    }
+
+    // Slab nodes are sequential, so the copy is a single forward write stream.
+    sll_node* dest = &slab->nodes[0];
+    sllist_iter it = sll_iter_begin(list, SLLIST_PREFETCH_DISTANCE);
+    for (void* data; (data = sll_iter_get(&it)) != NULL; sll_iter_next(&it)) {
+        memcpy(sll_payload(list, dest), data, list->data_size);
+        dest++;
+    }
+    return slab;
+}
+
+
+/**
+ * @brief Creates a new singly linked list.
+ *
+ * This function initializes a new singly linked list with the specified data size for each node.
+ *
+ * @param data_size The size of the data to be stored in each node.
+ * @return A pointer to the newly created singly linked list, or NULL if memory allocation fails.
+ * 
+ * @usage
+ * sllist* my_list = sllist_create(sizeof(int));
+ * if (my_list == NULL) {
+ *     // Handle memory allocation failure
+ * }
+ */
+sllist* sllist_create(size_t data_size) {
+    SLL_PROBE_SCOPE(NULL, 0);
+    return sll_create(data_size, NULL);
+}
+
+
+/**
+ * @brief Creates a new singly linked list whose memory comes from a custom allocator.
+ *
+ * The list structure, its nodes and their data are all obtained from `allocator`, which is copied
+ * into the list. Clones and copies of the list use the same allocator, so `allocator->ctx` must
+ * outlive all of them.
+ *
+ * @param data_size The size of the data to be stored in each node.
+ * @param allocator The allocator to use, or NULL for the default allocator, which keeps freed small
+ *                  blocks in per-thread caches and a shared depot for reuse before falling back to malloc().
+ * @return A pointer to the newly created singly linked list, or NULL if memory allocation fails.
+ *
+ * @usage
+ * sllist_allocator pool_allocator = { pool_alloc, pool_free, &request_pool };
+ * sllist* scratch = sllist_create_with_allocator(sizeof(int), &pool_allocator);
+ */
+sllist* sllist_create_with_allocator(size_t data_size, const sllist_allocator* allocator) {
+    SLL_PROBE_SCOPE(NULL, 0);
+    return sll_create(data_size, allocator);
+}
+
+
+/**
+ * @brief Creates a new singly linked list whose payloads are aligned to `alignment` bytes.
+ *
+ * Every element's data starts at a multiple of `alignment`, so types that need more than the default
+ * alignment (such as SIMD vectors) can be loaded with aligned instructions. The space reserved for each
+ * payload is also rounded up to a multiple of `alignment`; with 64-byte (cache line) alignment, no
+ * two elements share a cache line, which avoids false sharing between threads updating neighbours.
+ *
+ * @param data_size The size of the data to be stored in each node.
+ * @param alignment The payload alignment, a power of two no greater than 4096.
+ * @return A pointer to the newly created singly linked list, or NULL if `alignment` is invalid or
+ *         memory allocation fails.
+ *
+ * @usage
+ * sllist* vectors = sllist_create_aligned(sizeof(record), 32); // record holds __m256 fields
+ */
+sllist* sllist_create_aligned(size_t data_size, size_t alignment) {
+    SLL_PROBE_SCOPE(NULL, 0);
+    if (alignment == 0 || (alignment & (alignment - 1)) != 0 || alignment > SLL_MAX_ALIGNMENT ||
+        data_size > SIZE_MAX - 2 * SLL_MAX_ALIGNMENT) {
+        return NULL; // Invalid parameters
+    }
+
+    sllist* list = sll_create(data_size, NULL);
+    if (!list) {
+        return NULL; // Memory allocation failed
+    }
+    list->alignment = alignment;
+    return list;
+}
+
+
+/**
+ * @brief Creates a new singly linked list whose nodes and data come from an arena owned by the list.
+ *
+ * Memory is bump-allocated from large chunks, so inserting costs no malloc() call in the common case,
+ * and free_sllist() or sllist_clear() release everything with a handful of free() calls regardless
+ * of the length of the list. Removing individual nodes does not return their memory until then.
+ * Cloning an arena list makes a deep copy in a new arena.
+ *
+ * @param data_size The size of the data to be stored in each node.
+ * @return A pointer to the newly created singly linked list, or NULL if memory allocation fails.
+ *
+ * @usage
+ * sllist* scratch = sllist_create_arena(sizeof(int));
+ * // ... build and use the list while handling a request ...
+ * free_sllist(scratch); // O(1) in the number of nodes
+ */
+sllist* sllist_create_arena(size_t data_size) {
+    SLL_PROBE_SCOPE(NULL, 0);
+    return sll_arena_create(data_size, -1, 0);
+}
+
+
+/**
+ * @brief Creates an arena list (see sllist_create_arena) backed by transparent huge pages.
+ *
+ * The arena maps its chunks in whole, 2 MB-aligned huge pages and advises the kernel to back them
+ * with huge pages (MADV_HUGEPAGE), so traversing tens of millions of nodes touches far fewer TLB
+ * entries. Where huge pages are unavailable the list works the same with regular pages.
+ *
+ * @param data_size The size of the data to be stored in each node.
+ * @return A pointer to the newly created singly linked list, or NULL if memory allocation fails.
+ *
+ * @usage
+ * sllist* big = sllist_create_hugepage(sizeof(long));
+ */
+sllist* sllist_create_hugepage(size_t data_size) {
+    SLL_PROBE_SCOPE(NULL, 0);
+    return sll_arena_create(data_size, -1, 1);
+}
+
+
+/**
+ * @brief Creates an arena list (see sllist_create_arena) whose memory is bound to a NUMA node.
+ *
+ * Every chunk of the arena is mapped with a policy that places its pages on `numa_node`, so scans
+ * from threads running on that node never pay remote-memory latency. Clones and copies are bound
+ * to the same node.
+ *
+ * @param data_size The size of the data to be stored in each node.
+ * @param numa_node The NUMA node to allocate from, or -1 for the node the calling thread runs on.
+ * @return A pointer to the newly created singly linked list, or NULL if the node cannot be used
+ *         (including on systems without NUMA support) or memory allocation fails.
+ *
+ * @usage
+ * sllist* index = sllist_create_numa(sizeof(entry), 1); // consumed by workers pinned to node 1
+ */
+sllist* sllist_create_numa(size_t data_size, int numa_node) {
+    SLL_PROBE_SCOPE(NULL, 0);
+    if (numa_node < 0) {
+        numa_node = sll_numa_current_node();
+    }
+    if (numa_node < 0 || numa_node >= SLL_NUMA_MAX_NODES) {
+        return NULL; // Invalid parameters
+    }
+
+    sllist* list = sll_arena_create(data_size, numa_node, 0);
+    if (!list) {
+        return NULL; // Memory allocation failed
+    }
+    // Map the first chunk now, so that an unusable node is reported here rather than by a failed insert.
+    if (!sll_arena_chunk_alloc((struct sll_arena*)list->allocator.ctx, SLL_ARENA_FIRST_CHUNK)) {
+        sll_destroy(list);
+        return NULL;
+    }
+    return list;
+}
+
+
+/**
+ * @brief Moves every node and its data to a NUMA node.
+ *
+ * Typically called by the thread that is about to scan a large list built elsewhere. For a list
+ * created by sllist_create_numa() the whole arena is rebound, so later insertions also land on the
+ * new node; for other lists each page holding a node or its data is migrated (other data sharing
+ * those pages moves with them). The list contents and addresses are unchanged.
+ *
+ * @param list A pointer to the singly linked list.
+ * @param numa_node The destination node, or -1 for the node the calling thread runs on.
+ * @return 0 on success, or -1 on failure (including on systems without NUMA support).
+ *
+ * @usage
+ * sllist_migrate_numa(shared_list, -1); // bring the list next to this thread
+ */
+int sllist_migrate_numa(sllist* list, int numa_node) {
+    SLL_PROBE_SCOPE(list, 0);
+    if (!list) {
+        return -1; // Invalid parameters
+    }
+    if (numa_node < 0) {
+        numa_node = sll_numa_current_node();
+    }
+    if (numa_node < 0 || numa_node >= SLL_NUMA_MAX_NODES) {
+        return -1; // Invalid parameters
+    }
+
+    if (sll_is_arena(list) && ((struct sll_arena*)list->allocator.ctx)->numa_node >= 0) {
+        struct sll_arena* arena = (struct sll_arena*)list->allocator.ctx;
+        int result = 0;
+        for (struct sll_arena_chunk* chunk = arena->chunks; chunk != NULL; chunk = chunk->next) {
+            if (sll_numa_bind(chunk, sizeof(struct sll_arena_chunk) + chunk->size, numa_node, MPOL_MF_MOVE) != 0) {
+                result = -1;
+            }
+        }
+        arena->numa_node = numa_node;
+        return result;
+    }
+
+#ifdef __linux__
+    // Collect the pages of nodes and payloads, skipping repeats of the previous page, and move them in batches.
+    uintptr_t page_mask = ~((uintptr_t)sysconf(_SC_PAGESIZE) - 1);
+    void* pages[SLL_MOVE_BATCH];
+    int nodes[SLL_MOVE_BATCH];
+    int status[SLL_MOVE_BATCH];
+    size_t count = 0;
+    int result = 0;
+    int inline_data = SLL_INLINE_DATA(list);
+    for (sll_node* node = list->head; node != NULL; node = node->next) {
+        void* addresses[2] = { node, inline_data ? NULL : node->data };
+        for (size_t i = 0; i < 2 && addresses[i] != NULL; i++) {
+            void* page = (void*)((uintptr_t)addresses[i] & page_mask);
+            if (count > 0 && pages[count - 1] == page) {
+                continue;
+            }
+            pages[count] = page;
+            nodes[count] = numa_node;
+            if (++count == SLL_MOVE_BATCH) {
+                if (syscall(SYS_move_pages, 0, count, pages, nodes, status, MPOL_MF_MOVE) < 0) {
+                    result = -1;
+                }
+                count = 0;
+            }
+        }
+    }
+    if (count > 0 && syscall(SYS_move_pages, 0, count, pages, nodes, status, MPOL_MF_MOVE) < 0) {
+        result = -1;
+    }
+    return result;
+#else
+    return -1; // No NUMA support
+#endif
+}
+
+
+/**
+ * @brief Inserts a new node at the front of the singly linked list.
+ *
+ * This function creates a new node with the provided data and inserts it at the beginning of the list.
+ *
+ * @param list A pointer to the singly linked list.
+ * @param data A pointer to the data to be stored in the new node.
+ * 
+ * @usage
+ * int value = 42;
+ * insert_front(my_list, &value);
+ * insert_front(my_list, &(int){10}); // Insert 10 at the front
+ */
+void insert_front(sllist* list, void* data) {
+    SLL_PROBE_SCOPE(list, 0);
+    SLL_OP_SCOPE(SLLIST_OP_INSERT_FRONT);
+    if (!list || !data) {
+        return; // Invalid parameters
+    }
+
+    sll_node* new_node = sll_node_alloc(list, data);
+    if (!new_node) {
+        return; // Memory allocation failed
+    }
+
+    new_node->next = list->head;
+    list->head = new_node;
+}
+
+
+/**
+ * @brief Inserts a new node at the end of the singly linked list.
+ *
+ * This function creates a new node with the provided data and inserts it at the end of the list.
+ *
+ * @param list A pointer to the singly linked list.
+ * @param data A pointer to the data to be stored in the new node.
+ * 
+ * @usage
+ * int value = 42;
+ * insert_end(my_list, &value);
+ * insert_end(my_list, &(int){10}); // Insert 10 at the end
+ */
+void insert_end(sllist* list, void* data) {
+    SLL_PROBE_SCOPE(list, 0);
+    SLL_OP_SCOPE(SLLIST_OP_INSERT_END);
+    if (!list || !data) {
+        return; // Invalid parameters
+    }
+
+    sll_node* new_node = sll_node_alloc(list, data);
+    if (!new_node) {
+        return; // Memory allocation failed
+    }
+
+    sll_node** link = &list->head;
+    size_t walked = 0;
+    while (*link != NULL) {
+        sll_node* current = sll_node_private(list, link);
+        if (!current) {
+            sll_node_free(list, new_node);
+            return; // Memory allocation failed
+        }
+        link = &current->next;
+        walked++;
+    }
+    *link = new_node;
+    sll_check_walk(list, SLLIST_OP_INSERT_END, walked);
+}
+
+
 /**
- * @brief Creates a new singly linked list.
+ * @brief Inserts a new node at the specified index in the singly linked list.
  *
- * This function initializes a new singly linked list with the specified data size for each node.
+ * This function creates a new node with the provided data and inserts it at the given index in the list.
+ * If the index is 0, the node is inserted at the front. If the index is equal to the length of the list,
+ * the node is inserted at the end. If the index is out of bounds, no insertion is performed.
  *
- * @param data_size The size of the data to be stored in each node.
- * @return A pointer to the newly created singly linked list, or NULL if memory allocation fails.
+ * @param list A pointer to the singly linked list.
+ * @param data A pointer to the data to be stored in the new node.
+ * @param index The position at which to insert the new node (0-based).
  * 
  * @usage
- * sllist* my_list = sllist_create(sizeof(int));
- * if (my_list == NULL) {
- *     // Handle memory allocation failure
- * }
+ * int value = 42;
+ * insert_at_index(my_list, &value, 2); // Insert 42 at index 2
+ * insert_at_index(my_list, &(int){10}, 0); // Insert 10 at the front
+ * insert_at_index(my_list, &(int){20}, sll_len(my_list)); // Insert 20 at the end
  */
-sllist* sllist_create(size_t data_size) {
-    sllist* list = (sllist*)malloc(sizeof(sllist));
+void insert_at_index(sllist* list, void* data, size_t index) {
+    SLL_PROBE_SCOPE(list, index);
+    SLL_OP_SCOPE(SLLIST_OP_INSERT_AT_INDEX);
+    if (!list || !data) {
+        return; // Invalid parameters
+    }
+
+    sll_node* new_node = sll_node_alloc(list, data);
+    if (!new_node) {
+        return; // Memory allocation failed
+    }
+
+    if (index == 0) {
+        new_node->next = list->head;
+        list->head = new_node;
+        return;
+    }
+
+    sll_node** link = &list->head;
+    for (size_t i = 0; i < index; i++) {
+        if (*link == NULL) {
+            sll_node_free(list, new_node);
+            return; // Index out of bounds
+        }
+        sll_node* current = sll_node_private(list, link);
+        if (!current) {
+            sll_node_free(list, new_node);
+            return; // Memory allocation failed
+        }
+        link = &current->next;
+    }
+
+    new_node->next = *link;
+    *link = new_node;
+    sll_check_walk(list, SLLIST_OP_INSERT_AT_INDEX, index);
+}
+
+
+/**
+ * @brief Frees the entire singly linked list and its nodes.
+ *
+ * This function traverses the list, frees each node's data and the node itself, and finally frees the list structure.
+ *
+ * @param list A pointer to the singly linked list to be freed.
+ * @usage
+ * free_sllist(my_list);
+ */
+void free_sllist(sllist* list) {
+    SLL_PROBE_SCOPE(list, 0);
+    sll_destroy(list);
+}
+
+
+/**
+ * @brief Removes every element, leaving an empty list that can be reused.
+ *
+ * For a list created by sllist_create_arena() this takes O(1) time in the number of elements: the
+ * arena is reset and keeps its largest chunk for the next round of insertions.
+ *
+ * @param list A pointer to the singly linked list.
+ * @usage
+ * sllist_clear(scratch); // ready for the next request
+ */
+void sllist_clear(sllist* list) {
+    SLL_PROBE_SCOPE(list, 0);
     if (!list) {
-        return NULL; // Memory allocation failed
+        return; // Invalid parameters
+    }
+    if (sll_is_arena(list)) {
+        sll_arena_reset((struct sll_arena*)list->allocator.ctx, 1);
+    } else {
+        sll_node_release(list, list->head);
+        sll_slab_release(list, list->slab);
+    }
+    list->head = NULL;
+    list->slab = NULL;
+    list->shared = 0;
+}
+
+
+/**
+ * @brief Body of the reclaimer thread: takes every queued list at once and frees them without holding the lock.
+ */
+static void* sll_reclaimer_main(void* arg) {
+    (void)arg;
+    pthread_mutex_lock(&sll_reclaimer.lock);
+    for (;;) {
+        while (sll_reclaimer.pending == NULL) {
+            sll_reclaimer.busy = 0;
+            pthread_cond_broadcast(&sll_reclaimer.idle);
+            pthread_cond_wait(&sll_reclaimer.work, &sll_reclaimer.lock);
+        }
+        struct sll_reclaim_item* batch = sll_reclaimer.pending;
+        sll_reclaimer.pending = NULL;
+        sll_reclaimer.busy = 1;
+        pthread_mutex_unlock(&sll_reclaimer.lock);
+
+        // Callers queueing more lists meanwhile only contend for the push, never for the frees.
+        while (batch != NULL) {
+            struct sll_reclaim_item* next = batch->next;
+            sll_destroy(batch->list);
+            free(batch);
+            batch = next;
+        }
+        pthread_mutex_lock(&sll_reclaimer.lock);
+    }
+    return NULL;
+}
+
+
+/**
+ * @brief Starts the reclaimer thread unless it is already running. Caller holds the reclaimer lock.
+ *
+ * @return Non-zero if the thread is running.
+ */
+static int sll_reclaimer_start(void) {
+    if (!sll_reclaimer.started) {
+        pthread_t thread;
+        if (pthread_create(&thread, NULL, sll_reclaimer_main, NULL) != 0) {
+            return 0; // Thread creation failed
+        }
+        pthread_detach(thread);
+        sll_reclaimer.started = 1;
+    }
+    return 1;
+}
+
+
+/**
+ * @brief Frees the list on a background thread and returns immediately.
+ *
+ * Only a small record is allocated and queued here, so the call takes O(1) time however long the
+ * list is; a reclaimer thread, started on first use, frees queued lists in batches. The list must
+ * not be used after this call. A custom allocator must accept frees from the reclaimer thread. If
+ * the thread cannot be started, the list is freed synchronously. After fork(), the child starts its
+ * own reclaimer on first use.
+ *
+ * @param list A pointer to the singly linked list to be freed.
+ * @usage
+ * sllist_free_async(huge_list); // returns without walking the nodes
+ */
+void sllist_free_async(sllist* list) {
+    SLL_PROBE_SCOPE(list, 0);
+    if (!list) {
+        return; // Invalid parameters
+    }
+
+    pthread_once(&sll_fork_once, sll_fork_init);
+    struct sll_reclaim_item* item = (struct sll_reclaim_item*)malloc(sizeof(struct sll_reclaim_item));
+    if (!item) {
+        sll_destroy(list); // Memory allocation failed: free in the caller
+        return;
+    }
+
+    item->list = list;
+    pthread_mutex_lock(&sll_reclaimer.lock);
+    if (!sll_reclaimer_start()) {
+        pthread_mutex_unlock(&sll_reclaimer.lock);
+        free(item);
+        sll_destroy(list); // No reclaimer available: free in the caller
+        return;
+    }
+    item->next = sll_reclaimer.pending;
+    sll_reclaimer.pending = item;
+    pthread_cond_signal(&sll_reclaimer.work);
+    pthread_mutex_unlock(&sll_reclaimer.lock);
+}
+
+
+/**
+ * @brief Blocks until every list passed to sllist_free_async() so far has been freed.
+ *
+ * Useful before shutdown or when measuring memory use.
+ *
+ * @usage
+ * sllist_reclaim_wait();
+ */
+void sllist_reclaim_wait(void) {
+    SLL_PROBE_SCOPE(NULL, 0);
+    pthread_mutex_lock(&sll_reclaimer.lock);
+    if (sll_reclaimer.pending != NULL && !sll_reclaimer_start()) {
+        // Lists queued before a fork, with no thread left to free them: free them here.
+        struct sll_reclaim_item* batch = sll_reclaimer.pending;
+        sll_reclaimer.pending = NULL;
+        pthread_mutex_unlock(&sll_reclaimer.lock);
+        while (batch != NULL) {
+            struct sll_reclaim_item* next = batch->next;
+            sll_destroy(batch->list);
+            free(batch);
+            batch = next;
+        }
+        return;
+    }
+    while (sll_reclaimer.pending != NULL || sll_reclaimer.busy) {
+        pthread_cond_wait(&sll_reclaimer.idle, &sll_reclaimer.lock);
+    }
+    pthread_mutex_unlock(&sll_reclaimer.lock);
+}
+
+
+/**
+ * @brief Frees the node at the front of the singly linked list.
+ *
+ * This function removes the node at the front of the list, frees its data and the node itself.
+ *
+ * @param list A pointer to the singly linked list.
+ * @usage
+ * free_at_front(my_list);
+ */
+void free_at_front(sllist* list) {
+    SLL_PROBE_SCOPE(list, 0);
+    SLL_OP_SCOPE(SLLIST_OP_FREE_AT_FRONT);
+    if (list->head == NULL) {
+        return; // List is empty
+    }
+
+    sll_unlink(list, &list->head);
+} 
+
+
+/**
+ * @brief Frees the node at the end of the singly linked list.
+ *
+ * This function removes the node at the end of the list, frees its data and the node itself.
+ *
+ * @param list A pointer to the singly linked list.
+ * @usage
+ * free_at_end(my_list);
+ */
+void free_at_end(sllist* list) {
+    SLL_PROBE_SCOPE(list, 0);
+    SLL_OP_SCOPE(SLLIST_OP_FREE_AT_END);
+    if (list->head == NULL) {
+        return; // List is empty
+    }
+
+    sll_node** link = &list->head;
+    size_t walked = 0;
+    while ((*link)->next != NULL) {
+        sll_node* current = sll_node_private(list, link);
+        if (!current) {
+            return; // Memory allocation failed
+        }
+        link = &current->next;
+        walked++;
+    }
+    sll_unlink(list, link);
+    sll_check_walk(list, SLLIST_OP_FREE_AT_END, walked);
+}
+
+
+/**
+ * @brief Frees the node at the specified index in the singly linked list.
+ *
+ * This function removes the node at the given index, frees its data and the node itself.
+ * If the index is 0, the front node is removed. If the index is out of bounds, no removal is performed.
+ *
+ * @param list A pointer to the singly linked list.
+ * @param index The position of the node to be removed (0-based).
+ * 
+ * @usage
+ * free_at_index(my_list, 2); // Remove node at index 2
+ * free_at_index(my_list, 0); // Remove front node
+ */
+void free_at_index(sllist* list, size_t index) {
+    SLL_PROBE_SCOPE(list, index);
+    SLL_OP_SCOPE(SLLIST_OP_FREE_AT_INDEX);
+    if (list->head == NULL) {
+        return; // List is empty
+    }
+
+    if (index == 0) {
+        sll_unlink(list, &list->head);
+        return;
+    }
+
+    sll_node** link = &list->head;
+    for (size_t i = 0; i < index; i++) {
+        if ((*link)->next == NULL) {
+            return; // Index out of bounds
+        }
+        sll_node* current = sll_node_private(list, link);
+        if (!current) {
+            return; // Memory allocation failed
+        }
+        link = &current->next;
+    }
+    sll_unlink(list, link);
+    sll_check_walk(list, SLLIST_OP_FREE_AT_INDEX, index);
+}
+
+
+/**
+ * @brief Returns the length of the singly linked list.
+ *
+ * This function traverses the list and counts the number of nodes.
+ *
+ * @param list A pointer to the singly linked list.
+ * @return The number of nodes in the list.
+ * 
+ * @usage
+ * size_t length = sll_len(my_list);
+ */
+size_t sll_len(sllist* list) {
+    SLL_PROBE_SCOPE(list, 0);
+    SLL_OP_SCOPE(SLLIST_OP_LEN);
+    size_t length = sll_count(list);
+    SLL_COUNT_NODES(length);
+    sll_check_walk(list, SLLIST_OP_LEN, length);
+    return length;
+}
+
+
+/**
+ * @brief Prints the singly linked list.
+ * This function traverses the list and prints each node's data using the provided print function.
+ * @param list A pointer to the singly linked list.
+ * @param print_func A function pointer to a function that takes a void pointer and prints the data.
+ * @usage
+ * void print_int(void* data) {
+ *     printf("%d -> ", *(int*)data);
+ * }
+ * print_sllist(my_list, print_int);
+ */
+void print_sllist(sllist* list, void (*print_func)(void*)) {
+    SLL_PROBE_SCOPE(list, 0);
+    sllist_iter it = sll_iter_begin(list, SLLIST_PREFETCH_DISTANCE);
+    for (void* data; (data = sll_iter_get(&it)) != NULL; sll_iter_next(&it)) {
+        print_func(data);
+    }
+    printf("NULL\n");
+}
+
+
+/**
+ * @brief Returns a pointer to the data stored in a node of the list.
+ *
+ * Use this rather than reading `node->data` directly: payloads no larger than a pointer are stored
+ * in the `data` field itself.
+ *
+ * @param list A pointer to the singly linked list the node belongs to.
+ * @param node A pointer to the node.
+ * @return A pointer to the node's data.
+ *
+ * @usage
+ * int first = *(int*)sll_node_data(my_list, my_list->head);
+ */
+void* sll_node_data(sllist* list, sll_node* node) {
+    SLL_PROBE_SCOPE(list, 0);
+    if (!list || !node) {
+        return NULL; // Invalid parameters
+    }
+    return sll_payload(list, node);
+}
+
+
+/**
+ * @brief Reports how much memory the list uses and how well its nodes are laid out, in one pass.
+ *
+ * `slack_bytes` is an estimate: for malloc()-backed memory it assumes a typical allocator with an
+ * 8-byte header per block and 16-byte rounding. `mean_node_gap` measures locality: values far above
+ * sizeof(sll_node) mean that traversals jump around the heap, and sllist_compact() would help.
+ * Nodes shared with clones are counted in full for each list.
+ *
+ * @param list A pointer to the singly linked list.
+ * @param out Receives the statistics.
+ * @return 0 on success, or -1 on invalid parameters.
+ *
+ * @usage
+ * sllist_memstats stats;
+ * sllist_stats(my_list, &stats);
+ * if (stats.mean_node_gap > 4096) {
+ *     sllist_compact(my_list);
+ * }
+ */
+int sllist_stats(sllist* list, sllist_memstats* out) {
+    SLL_PROBE_SCOPE(list, 0);
+    if (!list || !out) {
+        return -1; // Invalid parameters
+    }
+
+    int inline_data = SLL_INLINE_DATA(list);
+    int arena = sll_is_arena(list);
+    size_t stride = inline_data ? 0 : sll_payload_stride(list);
+    size_t count = 0;
+    size_t in_slab = 0;
+    size_t separate_slack = 0;
+    double gaps = 0.0;
+    const sll_node* previous = NULL;
+    for (sll_node* node = list->head; node != NULL; node = node->next) {
+        count++;
+        if (sll_in_slab(list, node)) {
+            in_slab++;
+        } else if (!arena) {
+            separate_slack += sll_block_slack(list, sizeof(sll_node));
+            if (!inline_data) {
+                size_t block = sll_payload_block_size(list);
+                separate_slack += sll_block_slack(list, block) + (block - stride);
+            }
+        }
+        if (previous != NULL) {
+            uintptr_t a = (uintptr_t)previous;
+            uintptr_t b = (uintptr_t)node;
+            uintptr_t gap = a > b ? a - b : b - a;
+            gaps += (double)(gap < SLL_STATS_MAX_GAP ? gap : SLL_STATS_MAX_GAP);
+        }
+        previous = node;
+    }
+    SLL_COUNT_NODES(count);
+
+    out->count = count;
+    out->payload_bytes = count * list->data_size;
+    // Inline payloads (stride 0) live inside the node structures, so they are not overhead either.
+    out->overhead_bytes = sizeof(sllist) + count * (sizeof(sll_node) + stride) - out->payload_bytes;
+    out->mean_node_gap = count > 1 ? gaps / (double)(count - 1) : 0.0;
+
+    // Unused slab space covers nodes removed since the last compaction, plus header and padding.
+    size_t slab_slack = 0;
+    if (list->slab != NULL) {
+        slab_slack = sll_slab_size(list, list->slab->count) - in_slab * (sizeof(sll_node) + stride);
     }
-    list->head = NULL;
-    list->data_size = data_size;
-    return list;
+
+    if (arena) {
+        // Everything the chunks hold beyond the live nodes and payloads is slack.
+        const struct sll_arena* owner = (const struct sll_arena*)list->allocator.ctx;
+        size_t reserved = 0;
+        for (const struct sll_arena_chunk* chunk = owner->chunks; chunk != NULL; chunk = chunk->next) {
+            reserved += chunk->size;
+        }
+        size_t live = count * (sizeof(sll_node) + stride) + slab_slack;
+        out->slack_bytes = reserved > live ? reserved - live : 0;
+    } else {
+        out->slack_bytes = separate_slack + slab_slack + sll_block_slack(list, sizeof(sllist));
+    }
+    return 0;
 }
 
 
 /**
- * @brief Inserts a new node at the front of the singly linked list.
+ * @brief Relocates every node and its data into one contiguous block in list order.
  *
- * This function creates a new node with the provided data and inserts it at the beginning of the list.
+ * After many insertions and removals the nodes of a long-lived list end up scattered across the
+ * heap. This function copies all nodes and payloads into a single allocation laid out in traversal
+ * order and relinks them, so that subsequent scans sweep memory linearly. Nodes removed from the
+ * block later are not returned to the system until the next compaction or free_sllist().
+ * If the block cannot be allocated, the list is left unchanged.
  *
  * @param list A pointer to the singly linked list.
- * @param data A pointer to the data to be stored in the new node.
- * 
  * @usage
- * int value = 42;
- * insert_front(my_list, &value);
- * insert_front(my_list, &(int){10}); // Insert 10 at the front
+ * sllist_compact(my_list); // e.g. during idle periods
  */
-void insert_front(sllist* list, void* data) {
-    if (!list || !data) {
-        return; // Invalid parameters
+void sllist_compact(sllist* list) {
+    SLL_PROBE_SCOPE(list, 0);
+    if (!list || list->head == NULL) {
+        return; // Invalid parameters or empty list
     }
 
-    struct sll_node* new_node = (sll_node*)malloc(sizeof(sll_node));
-    if (!new_node) {
+    struct sll_slab* slab = sll_slab_copy(list, list);
+    if (!slab) {
         return; // Memory allocation failed
     }
 
-    new_node->data = malloc(list->data_size);
-    if (!new_node->data) {
-        free(new_node);
-        return; // Memory allocation failed
+    // Release the old chain only after copying: freeing a node can cascade into its successors.
+    sll_node_release(list, list->head);
+    sll_slab_release(list, list->slab);
+    list->slab = slab;
+    list->head = &slab->nodes[0];
+    list->shared = 0; // Every node is now in the fresh slab
+}
+
+
+/**
+ * @brief Body of sllist_copy().
+ */
+static sllist* sll_copy(sllist* list) {
+    if (!list) {
+        return NULL; // Invalid parameters
     }
-    memcpy(new_node->data, data, list->data_size);
 
-    new_node->next = list->head;
-    list->head = new_node;
+    sllist* copy = sll_create_like(list);
+    if (!copy || list->head == NULL) {
+        return copy;
+    }
+
+    struct sll_slab* slab = sll_slab_copy(copy, list);
+    if (!slab) {
+        sll_destroy(copy);
+        return NULL; // Memory allocation failed
+    }
+    copy->slab = slab;
+    copy->head = &slab->nodes[0];
+    return copy;
 }
 
 
 /**
- * @brief Inserts a new node at the end of the singly linked list.
+ * @brief Returns a logically independent copy of the list in O(1).
  *
- * This function creates a new node with the provided data and inserts it at the end of the list.
+ * The clone shares every node with the original. Whichever list is modified first copies only the
+ * nodes leading up to the modified position; the rest stays shared. Each list may be used from its
+ * own thread. Data reached through a shared node must not be modified in place.
+ *
+ * Both lists then check reference counts on every modification; a list that was never cloned, or
+ * was cleared or compacted since, skips them.
  *
  * @param list A pointer to the singly linked list.
- * @param data A pointer to the data to be stored in the new node.
- * 
+ * @return A pointer to the clone, or NULL if memory allocation fails. Free it with free_sllist().
+ *
  * @usage
- * int value = 42;
- * insert_end(my_list, &value);
- * insert_end(my_list, &(int){10}); // Insert 10 at the end
+ * sllist* snapshot = sllist_clone(my_list);
+ * insert_front(my_list, &(int){1}); // snapshot is unaffected
+ * free_sllist(snapshot);
  */
-void insert_end(sllist* list, void* data) {
-    if (!list || !data) {
-        return; // Invalid parameters
+sllist* sllist_clone(sllist* list) {
+    SLL_PROBE_SCOPE(list, 0);
+    if (!list) {
+        return NULL; // Invalid parameters
     }
 
-    struct sll_node* new_node = (sll_node*)malloc(sizeof(sll_node));
-    if (!new_node) {
-        return; // Memory allocation failed
+    if (sll_is_arena(list)) {
+        return sll_copy(list); // Arena memory cannot outlive its list, so nothing is shared
     }
 
-    new_node->data = malloc(list->data_size);
-    if (!new_node->data) {
-        free(new_node);
-        return; // Memory allocation failed
+    sllist* clone = sll_create_like(list);
+    if (!clone) {
+        return NULL; // Memory allocation failed
     }
-    memcpy(new_node->data, data, list->data_size);
-    new_node->next = NULL;
-
-    if (list->head == NULL) {
-        list->head = new_node;
-    } else {
-        sll_node* current = list->head;
-        while (current->next != NULL) {
-            current = current->next;
-        }
-        current->next = new_node;
+    clone->head = list->head;
+    if (clone->head != NULL) {
+        SLL_REF_INC(clone->head);
+    }
+    clone->slab = list->slab;
+    if (clone->slab != NULL) {
+        SLL_REF_INC(clone->slab);
     }
+    list->shared = 1;
+    clone->shared = 1;
+    return clone;
 }
 
 
 /**
- * @brief Inserts a new node at the specified index in the singly linked list.
+ * @brief Returns a deep copy of the list.
  *
- * This function creates a new node with the provided data and inserts it at the given index in the list.
- * If the index is 0, the node is inserted at the front. If the index is equal to the length of the list,
- * the node is inserted at the end. If the index is out of bounds, no insertion is performed.
+ * All nodes and data of the copy are allocated as one contiguous block and filled in a single pass,
+ * instead of one insert_end() per element. The copy shares nothing with the original.
  *
  * @param list A pointer to the singly linked list.
- * @param data A pointer to the data to be stored in the new node.
- * @param index The position at which to insert the new node (0-based).
- * 
+ * @return A pointer to the copy, or NULL if memory allocation fails. Free it with free_sllist().
+ *
  * @usage
- * int value = 42;
- * insert_at_index(my_list, &value, 2); // Insert 42 at index 2
- * insert_at_index(my_list, &(int){10}, 0); // Insert 10 at the front
- * insert_at_index(my_list, &(int){20}, sll_len(my_list)); // Insert 20 at the end
+ * sllist* backup = sllist_copy(my_list);
+ * if (backup == NULL) {
+ *     // Handle memory allocation failure
+ * }
  */
-void insert_at_index(sllist* list, void* data, size_t index) {
-    if (!list || !data) {
-        return; // Invalid parameters
-    }
+sllist* sllist_copy(sllist* list) {
+    SLL_PROBE_SCOPE(list, 0);
+    return sll_copy(list);
+}
 
-    struct sll_node* new_node = (sll_node*)malloc(sizeof(sll_node));
-    if (!new_node) {
-        return; // Memory allocation failed
+
+/**
+ * @brief Creates a read-only snapshot of the list with O(1) indexed access.
+ *
+ * All payloads are copied, in list order, into one contiguous array. The list itself is not modified
+ * and later changes to it are not reflected in the snapshot.
+ *
+ * @param list A pointer to the singly linked list.
+ * @return A pointer to the snapshot, or NULL if memory allocation fails.
+ *
+ * @usage
+ * sllist_frozen* view = sllist_freeze(my_list);
+ * if (view == NULL) {
+ *     // Handle memory allocation failure
+ * }
+ */
+sllist_frozen* sllist_freeze(sllist* list) {
+    SLL_PROBE_SCOPE(list, 0);
+    if (!list) {
+        return NULL; // Invalid parameters
     }
 
-    new_node->data = malloc(list->data_size);
-    if (!new_node->data) {
-        free(new_node);
-        return; // Memory allocation failed
+    size_t count = sll_count(list);
+    size_t data_offset = sll_align_up(sizeof(sllist_frozen), _Alignof(max_align_t));
+    if (list->data_size != 0 && count > (SIZE_MAX - data_offset) / list->data_size) {
+        return NULL; // Size overflow
     }
-    memcpy(new_node->data, data, list->data_size);
-    new_node->next = NULL;
 
-    if (index == 0) {
-        new_node->next = list->head;
-        list->head = new_node;
-        return;
+    sllist_frozen* frozen = (sllist_frozen*)malloc(data_offset + count * list->data_size);
+    if (!frozen) {
+        return NULL; // Memory allocation failed
     }
+    frozen->data = (unsigned char*)frozen + data_offset;
+    frozen->count = count;
+    frozen->data_size = list->data_size;
 
-    sll_node* current = list->head;
-    for (size_t i = 0; i < index - 1; i++) {
-        if (current == NULL) {
-            free(new_node->data);
-            free(new_node);
-            return; // Index out of bounds
-        }
-        current = current->next;
+    unsigned char* dest = (unsigned char*)frozen->data;
+    sllist_iter it = sll_iter_begin(list, SLLIST_PREFETCH_DISTANCE);
+    for (void* data; (data = sll_iter_get(&it)) != NULL; sll_iter_next(&it)) {
+        memcpy(dest, data, list->data_size);
+        dest += list->data_size;
     }
+    return frozen;
+}
 
-    if (current == NULL) {
-        free(new_node->data);
-        free(new_node);
-        return; // Index out of bounds
+
+/**
+ * @brief Returns the element at the given index of a snapshot.
+ *
+ * @param frozen A pointer to the snapshot.
+ * @param index The position of the element (0-based).
+ * @return A pointer to the element's data, or NULL if the index is out of bounds.
+ *
+ * @usage
+ * int value = *(int*)sllist_frozen_get(view, 2);
+ */
+void* sllist_frozen_get(const sllist_frozen* frozen, size_t index) {
+    SLL_PROBE_SCOPE(frozen, index);
+    if (!frozen || index >= frozen->count) {
+        return NULL; // Index out of bounds
     }
+    return (unsigned char*)frozen->data + index * frozen->data_size;
+}
+
 
-    new_node->next = current->next;
-    current->next = new_node;
+/**
+ * @brief Binary-searches a snapshot whose elements are sorted according to `compare`.
+ *
+ * @param frozen A pointer to the snapshot.
+ * @param key A pointer to the value to look for.
+ * @param compare A qsort-style comparison function.
+ * @return A pointer to a matching element, or NULL if there is none.
+ *
+ * @usage
+ * int cmp_int(const void* a, const void* b) {
+ *     return (*(const int*)a > *(const int*)b) - (*(const int*)a < *(const int*)b);
+ * }
+ * int* found = sllist_frozen_search(view, &(int){42}, cmp_int);
+ */
+void* sllist_frozen_search(const sllist_frozen* frozen, const void* key,
+                           int (*compare)(const void*, const void*)) {
+    SLL_PROBE_SCOPE(frozen, 0);
+    if (!frozen || !key || !compare || frozen->count == 0) {
+        return NULL; // Invalid parameters or empty snapshot
+    }
+    return bsearch(key, frozen->data, frozen->count, frozen->data_size, compare);
 }
 
 
 /**
- * @brief Frees the entire singly linked list and its nodes.
+ * @brief Builds a new list from a snapshot.
  *
- * This function traverses the list, frees each node's data and the node itself, and finally frees the list structure.
+ * The nodes and data of the new list are allocated as a single contiguous block, as by sllist_compact().
+ * The snapshot remains valid and must still be freed with free_sllist_frozen().
+ *
+ * @param frozen A pointer to the snapshot.
+ * @return A pointer to the new list, or NULL if memory allocation fails.
  *
- * @param list A pointer to the singly linked list to be freed.
  * @usage
- * free_sllist(my_list);
+ * sllist* copy = sllist_thaw(view);
  */
-void free_sllist(sllist* list) {
-    sll_node* current = list->head;
-    sll_node* next_node;
+sllist* sllist_thaw(const sllist_frozen* frozen) {
+    SLL_PROBE_SCOPE(frozen, 0);
+    if (!frozen) {
+        return NULL; // Invalid parameters
+    }
+
+    sllist* list = sll_create(frozen->data_size, NULL);
+    if (!list || frozen->count == 0) {
+        return list;
+    }
 
-    while (current != NULL) {
-        next_node = current->next;
-        free(current->data);
-        free(current);
-        current = next_node;
+    struct sll_slab* slab = sll_slab_alloc(list, frozen->count);
+    if (!slab) {
+        sll_destroy(list);
+        return NULL; // Memory allocation failed
     }
+    sll_slab_fill(list, slab, frozen->data, frozen->count);
+    list->slab = slab;
+    list->head = &slab->nodes[0];
+    return list;
+}
+
 
-    free(list);
+/**
+ * @brief Frees a snapshot created by sllist_freeze().
+ *
+ * @param frozen A pointer to the snapshot to be freed.
+ * @usage
+ * free_sllist_frozen(view);
+ */
+void free_sllist_frozen(sllist_frozen* frozen) {
+    SLL_PROBE_SCOPE(frozen, 0);
+    free(frozen);
 }
 
 
 /**
- * @brief Frees the node at the front of the singly linked list.
+ * @brief Writes the list to a binary stream.
  *
- * This function removes the node at the front of the list, frees its data and the node itself.
+ * The format is a small header (magic, version, data size, element count) followed by every
+ * payload back to back in list order, in the machine's native byte order.
  *
  * @param list A pointer to the singly linked list.
+ * @param fp A stream opened for binary writing.
+ * @return 0 on success, or -1 if a write fails.
+ *
  * @usage
- * free_at_front(my_list);
+ * FILE* fp = fopen("list.bin", "wb");
+ * if (sllist_save(my_list, fp) != 0) {
+ *     // Handle write failure
+ * }
+ * fclose(fp);
  */
-void free_at_front(sllist* list) {
-    if (list->head == NULL) {
-        return; // List is empty
+int sllist_save(sllist* list, FILE* fp) {
+    SLL_PROBE_SCOPE(list, 0);
+    if (!list || !fp) {
+        return -1; // Invalid parameters
     }
 
-    sll_node* temp = list->head;
-    list->head = list->head->next;
-    free(temp->data);
-    free(temp);
-} 
+    // Count the nodes and note whether they are still exactly the slab, in order;
+    // in that case the payloads are already contiguous and go out in one write.
+    size_t count = 0;
+    int contiguous = list->slab != NULL && sll_payloads_packed(list);
+    for (sll_node* current = list->head; current != NULL; current = current->next) {
+        if (contiguous && (count >= list->slab->count || current != &list->slab->nodes[count])) {
+            contiguous = 0;
+        }
+        count++;
+    }
+    contiguous = contiguous && count == list->slab->count;
+
+    struct sll_file_header header;
+    memcpy(header.magic, SLL_FILE_MAGIC, sizeof(header.magic));
+    header.version = SLL_FILE_VERSION;
+    header.data_size = list->data_size;
+    header.count = count;
+    if (fwrite(&header, sizeof(header), 1, fp) != 1) {
+        return -1; // Write failed
+    }
+    if (count == 0 || list->data_size == 0) {
+        return 0;
+    }
+
+    if (contiguous) {
+        return fwrite(list->head->data, list->data_size, count, fp) == count ? 0 : -1;
+    }
+
+    sllist_iter it = sll_iter_begin(list, SLLIST_PREFETCH_DISTANCE);
+    for (void* data; (data = sll_iter_get(&it)) != NULL; sll_iter_next(&it)) {
+        if (fwrite(data, list->data_size, 1, fp) != 1) {
+            return -1; // Write failed
+        }
+    }
+    return 0;
+}
 
 
 /**
- * @brief Frees the node at the end of the singly linked list.
+ * @brief Reads a list written by sllist_save().
  *
- * This function removes the node at the end of the list, frees its data and the node itself.
+ * All nodes and data are allocated as one contiguous block (as by sllist_compact()) and the
+ * payloads are filled with a single read.
+ *
+ * @param fp A stream opened for binary reading, positioned at the start of a saved list.
+ * @return A pointer to the new list, or NULL if the stream is malformed, truncated, or memory allocation fails.
  *
- * @param list A pointer to the singly linked list.
  * @usage
- * free_at_end(my_list);
+ * FILE* fp = fopen("list.bin", "rb");
+ * sllist* my_list = sllist_load(fp);
+ * fclose(fp);
  */
-void free_at_end(sllist* list) {
-    if (list->head == NULL) {
-        return; // List is empty
+sllist* sllist_load(FILE* fp) {
+    SLL_PROBE_SCOPE(NULL, 0);
+    if (!fp) {
+        return NULL; // Invalid parameters
     }
 
-    if (list->head->next == NULL) {
-        free(list->head->data);
-        free(list->head);
-        list->head = NULL;
-        return;
+    struct sll_file_header header;
+    if (fread(&header, sizeof(header), 1, fp) != 1) {
+        return NULL; // Read failed
+    }
+    if (memcmp(header.magic, SLL_FILE_MAGIC, sizeof(header.magic)) != 0 ||
+        header.version != SLL_FILE_VERSION ||
+        header.data_size > SIZE_MAX || header.count > SIZE_MAX) {
+        return NULL; // Not a saved list, or not representable on this machine
     }
 
-    sll_node* current = list->head;
-    while (current->next->next != NULL) {
-        current = current->next;
+    sllist* list = sll_create((size_t)header.data_size, NULL);
+    if (!list || header.count == 0) {
+        return list;
     }
 
-    free(current->next->data);
-    free(current->next);
-    current->next = NULL;
+    size_t count = (size_t)header.count;
+    struct sll_slab* slab = sll_slab_alloc(list, count);
+    if (!slab) {
+        sll_destroy(list);
+        return NULL; // Memory allocation failed
+    }
+    if (sll_payloads_packed(list)) {
+        if (fread(slab->nodes[0].data, list->data_size, count, fp) != count) {
+            sll_slab_release(list, slab);
+            sll_destroy(list);
+            return NULL; // Truncated stream
+        }
+    } else {
+        // Inline payloads sit inside the nodes; read them through a small bounce buffer.
+        unsigned char buffer[4096];
+        size_t per_read = list->data_size ? sizeof(buffer) / list->data_size : count;
+        for (size_t done = 0; done < count; ) {
+            size_t n = count - done < per_read ? count - done : per_read;
+            if (list->data_size != 0 && fread(buffer, list->data_size, n, fp) != n) {
+                sll_slab_release(list, slab);
+                sll_destroy(list);
+                return NULL; // Truncated stream
+            }
+            for (size_t i = 0; i < n; i++) {
+                memcpy(&slab->nodes[done + i].data, buffer + i * list->data_size, list->data_size);
+            }
+            done += n;
+        }
+    }
+    list->slab = slab;
+    list->head = &slab->nodes[0];
+    return list;
 }
 
 
 /**
- * @brief Frees the node at the specified index in the singly linked list.
+ * @brief Returns an iterator positioned at the first node of the list.
  *
- * This function removes the node at the given index, frees its data and the node itself.
- * If the index is 0, the front node is removed. If the index is out of bounds, no removal is performed.
+ * Nodes up to `prefetch_distance` positions ahead are prefetched while the iterator advances.
+ * A distance of 0 disables prefetching.
  *
  * @param list A pointer to the singly linked list.
- * @param index The position of the node to be removed (0-based).
- * 
+ * @param prefetch_distance How many nodes ahead of the current one to prefetch.
+ * @return An iterator over the list; it is already exhausted if the list is empty.
+ *
  * @usage
- * free_at_index(my_list, 2); // Remove node at index 2
- * free_at_index(my_list, 0); // Remove front node
+ * sllist_iter it = sllist_iter_begin(my_list, SLLIST_PREFETCH_DISTANCE);
+ * for (int* value; (value = sllist_iter_get(&it)) != NULL; sllist_iter_next(&it)) {
+ *     sum += *value;
+ * }
  */
-void free_at_index(sllist* list, size_t index) {
-    if (list->head == NULL) {
-        return; // List is empty
-    }
+sllist_iter sllist_iter_begin(sllist* list, size_t prefetch_distance) {
+    SLL_PROBE_SCOPE(list, 0);
+    return sll_iter_begin(list, prefetch_distance);
+}
 
-    if (index == 0) {
-        free_at_front(list);
-        return;
+
+/**
+ * @brief Advances the iterator to the next node.
+ *
+ * Does nothing if the iterator is already exhausted.
+ *
+ * @param it A pointer to the iterator.
+ * @usage
+ * sllist_iter_next(&it);
+ */
+void sllist_iter_next(sllist_iter* it) {
+    SLL_PROBE_SCOPE(it, 0);
+    sll_iter_next(it);
+}
+
+
+/**
+ * @brief Returns the data of the node the iterator is positioned at.
+ *
+ * @param it A pointer to the iterator.
+ * @return A pointer to the node's data, or NULL once the iterator is exhausted.
+ *
+ * @usage
+ * int* value = sllist_iter_get(&it);
+ */
+void* sllist_iter_get(sllist_iter* it) {
+    SLL_PROBE_SCOPE(it, 0);
+    return sll_iter_get(it);
+}
+
+
+/**
+ * @brief Reads the counters of one operation.
+ *
+ * Counting is compiled in only when the library is built with -DSLLIST_INSTRUMENT; otherwise the
+ * operations carry no instrumentation at all and this function always fails.
+ *
+ * @param op The operation.
+ * @param out Receives the counters (zeroed on failure).
+ * @return 0 on success, or -1 if `op` is invalid or instrumentation is not compiled in.
+ *
+ * @usage
+ * sllist_op_stats st;
+ * if (sllist_op_stats_get(SLLIST_OP_INSERT_END, &st) == 0) {
+ *     printf("%.1f nodes per insert_end\n", (double)st.nodes_traversed / st.calls);
+ * }
+ */
+int sllist_op_stats_get(sllist_op op, sllist_op_stats* out) {
+    if (!out) {
+        return -1; // Invalid parameters
+    }
+    memset(out, 0, sizeof(*out));
+#ifdef SLLIST_INSTRUMENT
+    if ((unsigned)op >= SLLIST_OP_COUNT) {
+        return -1; // Invalid parameters
     }
+    const sllist_op_stats* stats = &sll_op_table[op];
+    out->calls = __atomic_load_n(&stats->calls, __ATOMIC_RELAXED);
+    out->nodes_traversed = __atomic_load_n(&stats->nodes_traversed, __ATOMIC_RELAXED);
+    out->allocations = __atomic_load_n(&stats->allocations, __ATOMIC_RELAXED);
+    for (size_t i = 0; i < SLLIST_LATENCY_BUCKETS; i++) {
+        out->latency[i] = __atomic_load_n(&stats->latency[i], __ATOMIC_RELAXED);
+    }
+    return 0;
+#else
+    (void)op;
+    return -1; // Instrumentation not compiled in
+#endif
+}
 
-    sll_node* current = list->head;
-    for (size_t i = 0; i < index - 1; i++) {
-        if (current->next == NULL) {
-            return; // Index out of bounds
+
+/**
+ * @brief Zeroes the counters of every operation.
+ *
+ * @usage
+ * sllist_op_stats_reset(); // Measure the next phase only
+ */
+void sllist_op_stats_reset(void) {
+#ifdef SLLIST_INSTRUMENT
+    for (size_t op = 0; op < SLLIST_OP_COUNT; op++) {
+        sllist_op_stats* stats = &sll_op_table[op];
+        __atomic_store_n(&stats->calls, 0, __ATOMIC_RELAXED);
+        __atomic_store_n(&stats->nodes_traversed, 0, __ATOMIC_RELAXED);
+        __atomic_store_n(&stats->allocations, 0, __ATOMIC_RELAXED);
+        for (size_t i = 0; i < SLLIST_LATENCY_BUCKETS; i++) {
+            __atomic_store_n(&stats->latency[i], 0, __ATOMIC_RELAXED);
         }
-        current = current->next;
     }
+#endif
+}
 
-    if (current->next == NULL) {
-        return; // Index out of bounds
-    }
 
-    sll_node* temp = current->next;
-    current->next = temp->next;
-    free(temp->data);
-    free(temp);
+/**
+ * @brief Writes the counters of every operation that was called as a text table, followed by its
+ * non-empty latency buckets.
+ *
+ * @param fp The output stream.
+ * @usage
+ * sllist_op_stats_dump(stderr);
+ */
+void sllist_op_stats_dump(FILE* fp) {
+    if (!fp) {
+        return; // Invalid parameters
+    }
+#ifndef SLLIST_INSTRUMENT
+    fprintf(fp, "sllist: instrumentation not compiled in (build with -DSLLIST_INSTRUMENT)\n");
+#else
+    fprintf(fp, "%-16s %12s %14s %14s\n", "operation", "calls", "nodes/call", "allocs/call");
+    for (size_t op = 0; op < SLLIST_OP_COUNT; op++) {
+        sllist_op_stats stats;
+        sllist_op_stats_get((sllist_op)op, &stats);
+        if (stats.calls == 0) {
+            continue;
+        }
+        fprintf(fp, "%-16s %12llu %14.2f %14.2f\n", sllist_op_name((sllist_op)op), (unsigned long long)stats.calls,
+                (double)stats.nodes_traversed / (double)stats.calls,
+                (double)stats.allocations / (double)stats.calls);
+        for (size_t i = 0; i < SLLIST_LATENCY_BUCKETS; i++) {
+            if (stats.latency[i] != 0) {
+                fprintf(fp, "    [%llu ns, %llu ns) %llu\n", 1ull << i, 1ull << (i + 1),
+                        (unsigned long long)stats.latency[i]);
+            }
+        }
+    }
+#endif
 }
 
 
 /**
- * @brief Returns the length of the singly linked list.
+ * @brief Returns the name of an operation, such as "insert_end".
  *
- * This function traverses the list and counts the number of nodes.
+ * @param op The operation.
+ * @return The name, or "unknown" if `op` is invalid.
  *
- * @param list A pointer to the singly linked list.
- * @return The number of nodes in the list.
- * 
  * @usage
- * size_t length = sll_len(my_list);
+ * fprintf(stderr, "%s\n", sllist_op_name(op));
  */
-size_t sll_len(sllist* list) {
-    size_t length = 0;
-    sll_node* current = list->head;
-    while (current != NULL) {
-        length++;
-        current = current->next;
+const char* sllist_op_name(sllist_op op) {
+    if ((unsigned)op >= SLLIST_OP_COUNT) {
+        return "unknown"; // Invalid parameters
     }
-    return length;
+    return sll_op_names[op];
 }
 
 
 /**
- * @brief Prints the singly linked list.
- * This function traverses the list and prints each node's data using the provided print function.
+ * @brief Installs a hook called whenever insert_end, insert_at_index, free_at_end, free_at_index or
+ * sll_len walks more than `threshold` nodes of this list.
+ *
+ * Use it to catch quadratic patterns, such as appending in a loop or indexing from the front, in
+ * production. A walk within the threshold costs one comparison; past it, the list is counted again
+ * to report its length. The hook is not inherited by clones or copies. Only calls made by the
+ * program are reported: walks the library makes for itself, such as the length taken by
+ * sllist_freeze() or sllist_copy(), never reach the hook.
+ *
  * @param list A pointer to the singly linked list.
- * @param print_func A function pointer to a function that takes a void pointer and prints the data.
+ * @param threshold Largest walk that does not call the hook.
+ * @param hook The function to call, or NULL to remove the hook.
+ * @param tag Passed unchanged to the hook, for example a name identifying the list.
+ *
  * @usage
- * void print_int(void* data) {
- *     printf("%d -> ", *(int*)data);
+ * void log_slow(sllist* list, sllist_op op, size_t walked, size_t length, void* tag) {
+ *     fprintf(stderr, "%s: %s walked %zu of %zu nodes\n", (const char*)tag, sllist_op_name(op), walked, length);
  * }
- * print_sllist(my_list, print_int);
+ * sllist_set_slow_op_hook(pending, 10000, log_slow, "pending");
  */
-void print_sllist(sllist* list, void (*print_func)(void*)) {
-    sll_node* current = list->head;
-    while (current != NULL) {
-        print_func(current->data);
-        current = current->next;
+void sllist_set_slow_op_hook(sllist* list, size_t threshold, sllist_slow_op_hook hook, void* tag) {
+    if (!list) {
+        return; // Invalid parameters
     }
-    printf("NULL\n");
+    list->slow_op_hook = hook;
+    list->slow_op_threshold = threshold;
+    list->slow_op_tag = tag;
 }
@@ -4,26 +4,153 @@
 
 #include <stdio.h>
 #include <stdlib.h>
+#include <stdint.h>
 
 
 /**
  * @brief Node structure for singly linked list.
+ *
+ * `refs` counts the references to the node (a list head or a predecessor's `next`). A node whose
+ * count is above one is shared with a clone of the list (see sllist_clone) and is never modified in place.
+ * Counts are only maintained on lists with `shared` set; elsewhere every node has one reference.
+ *
+ * When the list's data_size is at most sizeof(void*) (and no larger alignment was requested), the
+ * payload is stored in the `data` field itself instead of a separate allocation; use sll_node_data()
+ * to reach it.
  */
 typedef struct sll_node {
     void* data;
     struct sll_node* next;
+    size_t refs;
 } sll_node;
 
 
+/**
+ * @brief Contiguous block of nodes and payloads owned by a list (see sllist_compact).
+ */
+struct sll_slab;
+
+
+/**
+ * @brief Memory allocator used by a list for its nodes and data (see sllist_create_with_allocator).
+ *
+ * `alloc` returns `size` bytes suitably aligned for any type, like malloc(), or NULL on failure.
+ * `free` releases a block returned by `alloc`; `size` is the size that was requested for it.
+ * `ctx` is passed unchanged to both callbacks.
+ */
+typedef struct sllist_allocator {
+    void* (*alloc)(void* ctx, size_t size);
+    void (*free)(void* ctx, void* ptr, size_t size);
+    void* ctx;
+} sllist_allocator;
+
+
+/**
+ * @brief List operations, as counted by the instrumentation layer (see sllist_op_stats_get) and
+ * reported to slow-operation hooks (see sllist_set_slow_op_hook).
+ */
+typedef enum sllist_op {
+    SLLIST_OP_INSERT_FRONT,
+    SLLIST_OP_INSERT_END,
+    SLLIST_OP_INSERT_AT_INDEX,
+    SLLIST_OP_FREE_AT_FRONT,
+    SLLIST_OP_FREE_AT_END,
+    SLLIST_OP_FREE_AT_INDEX,
+    SLLIST_OP_LEN,
+    SLLIST_OP_COUNT
+} sllist_op;
+
+
+struct sllist;
+
+
+/**
+ * @brief Called when an operation walks more nodes than the list's threshold (see sllist_set_slow_op_hook).
+ *
+ * `nodes_walked` is the number of nodes the operation stepped over, `length` the list length once it
+ * completed, and `tag` the value given to sllist_set_slow_op_hook().
+ */
+typedef void (*sllist_slow_op_hook)(struct sllist* list, sllist_op op, size_t nodes_walked, size_t length, void* tag);
+
+
 /**
  * @brief Singly linked list structure.
  */
 typedef struct sllist {
     struct sll_node* head;
     size_t data_size;
+    struct sll_slab* slab;
+    sllist_allocator allocator;
+    size_t alignment; // Payload alignment chosen at creation, or 0 for the default
+    sllist_slow_op_hook slow_op_hook; // NULL unless set with sllist_set_slow_op_hook()
+    size_t slow_op_threshold;
+    void* slow_op_tag;
+    int shared; // Non-zero once nodes may be shared with a clone (see sllist_clone)
 } sllist;
 
 
+/**
+ * @brief Read-only snapshot of a list with its payloads stored contiguously.
+ *
+ * Element i lives at `(char*)data + i * data_size`, in the list order at the time of the freeze.
+ */
+typedef struct sllist_frozen {
+    void* data;
+    size_t count;
+    size_t data_size;
+} sllist_frozen;
+
+
+/**
+ * @brief Memory usage of a list, as reported by sllist_stats().
+ */
+typedef struct sllist_memstats {
+    size_t count;          // Number of elements
+    size_t payload_bytes;  // count * data_size: the data itself
+    size_t overhead_bytes; // List header, node structures and alignment padding
+    size_t slack_bytes;    // Estimated memory held beyond the above: allocator headers and rounding, unused slab and arena space
+    double mean_node_gap;  // Mean distance in bytes between consecutive nodes (each capped at 1 MiB); sizeof(sll_node) when perfectly packed
+} sllist_memstats;
+
+
+/**
+ * @brief Default prefetch distance (in nodes) for list iterators.
+ */
+#define SLLIST_PREFETCH_DISTANCE 2
+
+
+/**
+ * @brief Forward iterator over a singly linked list.
+ *
+ * The iterator keeps a second cursor `prefetch_distance` nodes ahead of the current one and
+ * prefetches that node and its payload, so the dependent loads of the traversal overlap.
+ */
+typedef struct sllist_iter {
+    struct sll_node* current;
+    struct sll_node* ahead;
+    int inline_data;
+} sllist_iter;
+
+
+/**
+ * @brief Number of latency buckets per operation. Bucket i counts calls that took [2^i, 2^(i+1)) ns;
+ * bucket 0 also counts calls under 1 ns and the last bucket everything beyond.
+ */
+#define SLLIST_LATENCY_BUCKETS 32
+
+
+/**
+ * @brief Counters of one operation since start-up or the last sllist_op_stats_reset(), summed over all
+ * lists and threads.
+ */
+typedef struct sllist_op_stats {
+    uint64_t calls;
+    uint64_t nodes_traversed; // Nodes stepped over while walking the list
+    uint64_t allocations;     // Blocks requested from the lists' allocators
+    uint64_t latency[SLLIST_LATENCY_BUCKETS];
+} sllist_op_stats;
+
+
 /**
  * @brief Creates a new singly linked list.
  *
@@ -41,6 +168,115 @@ typedef struct sllist {
 sllist* sllist_create(size_t data_size);
 
 
+/**
+ * @brief Creates a new singly linked list whose memory comes from a custom allocator.
+ *
+ * The list structure, its nodes and their data are all obtained from `allocator`, which is copied
+ * into the list. Clones and copies of the list use the same allocator, so `allocator->ctx` must
+ * outlive all of them.
+ *
+ * @param data_size The size of the data to be stored in each node.
+ * @param allocator The allocator to use, or NULL for the default allocator, which keeps freed small
+ *                  blocks in per-thread caches and a shared depot for reuse before falling back to malloc().
+ * @return A pointer to the newly created singly linked list, or NULL if memory allocation fails.
+ *
+ * @usage
+ * sllist_allocator pool_allocator = { pool_alloc, pool_free, &request_pool };
+ * sllist* scratch = sllist_create_with_allocator(sizeof(int), &pool_allocator);
+ */
+sllist* sllist_create_with_allocator(size_t data_size, const sllist_allocator* allocator);
+
+
+/**
+ * @brief Creates a new singly linked list whose payloads are aligned to `alignment` bytes.
+ *
+ * Every element's data starts at a multiple of `alignment`, so types that need more than the default
+ * alignment (such as SIMD vectors) can be loaded with aligned instructions. The space reserved for each
+ * payload is also rounded up to a multiple of `alignment`; with 64-byte (cache line) alignment, no
+ * two elements share a cache line, which avoids false sharing between threads updating neighbours.
+ *
+ * @param data_size The size of the data to be stored in each node.
+ * @param alignment The payload alignment, a power of two no greater than 4096.
+ * @return A pointer to the newly created singly linked list, or NULL if `alignment` is invalid or
+ *         memory allocation fails.
+ *
+ * @usage
+ * sllist* vectors = sllist_create_aligned(sizeof(record), 32); // record holds __m256 fields
+ */
+sllist* sllist_create_aligned(size_t data_size, size_t alignment);
+
+
+/**
+ * @brief Creates a new singly linked list whose nodes and data come from an arena owned by the list.
+ *
+ * Memory is bump-allocated from large chunks, so inserting costs no malloc() call in the common case,
+ * and free_sllist() or sllist_clear() release everything with a handful of free() calls regardless
+ * of the length of the list. Removing individual nodes does not return their memory until then.
+ * Cloning an arena list makes a deep copy in a new arena.
+ *
+ * @param data_size The size of the data to be stored in each node.
+ * @return A pointer to the newly created singly linked list, or NULL if memory allocation fails.
+ *
+ * @usage
+ * sllist* scratch = sllist_create_arena(sizeof(int));
+ * // ... build and use the list while handling a request ...
+ * free_sllist(scratch); // O(1) in the number of nodes
+ */
+sllist* sllist_create_arena(size_t data_size);
+
+
+/**
+ * @brief Creates an arena list (see sllist_create_arena) backed by transparent huge pages.
+ *
+ * The arena maps its chunks in whole, 2 MB-aligned huge pages and advises the kernel to back them
+ * with huge pages (MADV_HUGEPAGE), so traversing tens of millions of nodes touches far fewer TLB
+ * entries. Where huge pages are unavailable the list works the same with regular pages.
+ *
+ * @param data_size The size of the data to be stored in each node.
+ * @return A pointer to the newly created singly linked list, or NULL if memory allocation fails.
+ *
+ * @usage
+ * sllist* big = sllist_create_hugepage(sizeof(long));
+ */
+sllist* sllist_create_hugepage(size_t data_size);
+
+
+/**
+ * @brief Creates an arena list (see sllist_create_arena) whose memory is bound to a NUMA node.
+ *
+ * Every chunk of the arena is mapped with a policy that places its pages on `numa_node`, so scans
+ * from threads running on that node never pay remote-memory latency. Clones and copies are bound
+ * to the same node.
+ *
+ * @param data_size The size of the data to be stored in each node.
+ * @param numa_node The NUMA node to allocate from, or -1 for the node the calling thread runs on.
+ * @return A pointer to the newly created singly linked list, or NULL if the node cannot be used
+ *         (including on systems without NUMA support) or memory allocation fails.
+ *
+ * @usage
+ * sllist* index = sllist_create_numa(sizeof(entry), 1); // consumed by workers pinned to node 1
+ */
+sllist* sllist_create_numa(size_t data_size, int numa_node);
+
+
+/**
+ * @brief Moves every node and its data to a NUMA node.
+ *
+ * Typically called by the thread that is about to scan a large list built elsewhere. For a list
+ * created by sllist_create_numa() the whole arena is rebound, so later insertions also land on the
+ * new node; for other lists each page holding a node or its data is migrated (other data sharing
+ * those pages moves with them). The list contents and addresses are unchanged.
+ *
+ * @param list A pointer to the singly linked list.
+ * @param numa_node The destination node, or -1 for the node the calling thread runs on.
+ * @return 0 on success, or -1 on failure (including on systems without NUMA support).
+ *
+ * @usage
+ * sllist_migrate_numa(shared_list, -1); // bring the list next to this thread
+ */
+int sllist_migrate_numa(sllist* list, int numa_node);
+
+
 /**
  * @brief Inserts a new node at the front of the singly linked list.
  *
@@ -105,6 +341,46 @@ void insert_at_index(sllist* list, void* data, size_t index);
 void free_sllist(sllist* list);
 
 
+/**
+ * @brief Removes every element, leaving an empty list that can be reused.
+ *
+ * For a list created by sllist_create_arena() this takes O(1) time in the number of elements: the
+ * arena is reset and keeps its largest chunk for the next round of insertions.
+ *
+ * @param list A pointer to the singly linked list.
+ * @usage
+ * sllist_clear(scratch); // ready for the next request
+ */
+void sllist_clear(sllist* list);
+
+
+/**
+ * @brief Frees the list on a background thread and returns immediately.
+ *
+ * Only a small record is allocated and queued here, so the call takes O(1) time however long the
+ * list is; a reclaimer thread, started on first use, frees queued lists in batches. The list must
+ * not be used after this call. A custom allocator must accept frees from the reclaimer thread. If
+ * the thread cannot be started, the list is freed synchronously. After fork(), the child starts its
+ * own reclaimer on first use.
+ *
+ * @param list A pointer to the singly linked list to be freed.
+ * @usage
+ * sllist_free_async(huge_list); // returns without walking the nodes
+ */
+void sllist_free_async(sllist* list);
+
+
+/**
+ * @brief Blocks until every list passed to sllist_free_async() so far has been freed.
+ *
+ * Useful before shutdown or when measuring memory use.
+ *
+ * @usage
+ * sllist_reclaim_wait();
+ */
+void sllist_reclaim_wait(void);
+
+
 /**
  * @brief Frees the node at the front of the singly linked list.
  *
@@ -173,4 +449,326 @@ size_t sll_len(sllist* list);
 void print_sllist(sllist* list, void (*print_func)(void*));
 
 
+/**
+ * @brief Returns a pointer to the data stored in a node of the list.
+ *
+ * Use this rather than reading `node->data` directly: payloads no larger than a pointer are stored
+ * in the `data` field itself.
+ *
+ * @param list A pointer to the singly linked list the node belongs to.
+ * @param node A pointer to the node.
+ * @return A pointer to the node's data.
+ *
+ * @usage
+ * int first = *(int*)sll_node_data(my_list, my_list->head);
+ */
+void* sll_node_data(sllist* list, sll_node* node);
+
+
+/**
+ * @brief Reports how much memory the list uses and how well its nodes are laid out, in one pass.
+ *
+ * `slack_bytes` is an estimate: for malloc()-backed memory it assumes a typical allocator with an
+ * 8-byte header per block and 16-byte rounding. `mean_node_gap` measures locality: values far above
+ * sizeof(sll_node) mean that traversals jump around the heap, and sllist_compact() would help.
+ * Nodes shared with clones are counted in full for each list.
+ *
+ * @param list A pointer to the singly linked list.
+ * @param out Receives the statistics.
+ * @return 0 on success, or -1 on invalid parameters.
+ *
+ * @usage
+ * sllist_memstats stats;
+ * sllist_stats(my_list, &stats);
+ * if (stats.mean_node_gap > 4096) {
+ *     sllist_compact(my_list);
+ * }
+ */
+int sllist_stats(sllist* list, sllist_memstats* out);
+
+
+/**
+ * @brief Relocates every node and its data into one contiguous block in list order.
+ *
+ * After many insertions and removals the nodes of a long-lived list end up scattered across the
+ * heap. This function copies all nodes and payloads into a single allocation laid out in traversal
+ * order and relinks them, so that subsequent scans sweep memory linearly. Nodes removed from the
+ * block later are not returned to the system until the next compaction or free_sllist().
+ * If the block cannot be allocated, the list is left unchanged.
+ *
+ * @param list A pointer to the singly linked list.
+ * @usage
+ * sllist_compact(my_list); // e.g. during idle periods
+ */
+void sllist_compact(sllist* list);
+
+
+/**
+ * @brief Returns a logically independent copy of the list in O(1).
+ *
+ * The clone shares every node with the original. Whichever list is modified first copies only the
+ * nodes leading up to the modified position; the rest stays shared. Each list may be used from its
+ * own thread. Data reached through a shared node must not be modified in place.
+ *
+ * Both lists then check reference counts on every modification; a list that was never cloned, or
+ * was cleared or compacted since, skips them.
+ *
+ * @param list A pointer to the singly linked list.
+ * @return A pointer to the clone, or NULL if memory allocation fails. Free it with free_sllist().
+ *
+ * @usage
+ * sllist* snapshot = sllist_clone(my_list);
+ * insert_front(my_list, &(int){1}); // snapshot is unaffected
+ * free_sllist(snapshot);
+ */
+sllist* sllist_clone(sllist* list);
+
+
+/**
+ * @brief Returns a deep copy of the list.
+ *
+ * All nodes and data of the copy are allocated as one contiguous block and filled in a single pass,
+ * instead of one insert_end() per element. The copy shares nothing with the original.
+ *
+ * @param list A pointer to the singly linked list.
+ * @return A pointer to the copy, or NULL if memory allocation fails. Free it with free_sllist().
+ *
+ * @usage
+ * sllist* backup = sllist_copy(my_list);
+ * if (backup == NULL) {
+ *     // Handle memory allocation failure
+ * }
+ */
+sllist* sllist_copy(sllist* list);
+
+
+/**
+ * @brief Creates a read-only snapshot of the list with O(1) indexed access.
+ *
+ * All payloads are copied, in list order, into one contiguous array. The list itself is not modified
+ * and later changes to it are not reflected in the snapshot.
+ *
+ * @param list A pointer to the singly linked list.
+ * @return A pointer to the snapshot, or NULL if memory allocation fails.
+ *
+ * @usage
+ * sllist_frozen* view = sllist_freeze(my_list);
+ * if (view == NULL) {
+ *     // Handle memory allocation failure
+ * }
+ */
+sllist_frozen* sllist_freeze(sllist* list);
+
+
+/**
+ * @brief Returns the element at the given index of a snapshot.
+ *
+ * @param frozen A pointer to the snapshot.
+ * @param index The position of the element (0-based).
+ * @return A pointer to the element's data, or NULL if the index is out of bounds.
+ *
+ * @usage
+ * int value = *(int*)sllist_frozen_get(view, 2);
+ */
+void* sllist_frozen_get(const sllist_frozen* frozen, size_t index);
+
+
+/**
+ * @brief Binary-searches a snapshot whose elements are sorted according to `compare`.
+ *
+ * @param frozen A pointer to the snapshot.
+ * @param key A pointer to the value to look for.
+ * @param compare A qsort-style comparison function.
+ * @return A pointer to a matching element, or NULL if there is none.
+ *
+ * @usage
+ * int cmp_int(const void* a, const void* b) {
+ *     return (*(const int*)a > *(const int*)b) - (*(const int*)a < *(const int*)b);
+ * }
+ * int* found = sllist_frozen_search(view, &(int){42}, cmp_int);
+ */
+void* sllist_frozen_search(const sllist_frozen* frozen, const void* key,
+                           int (*compare)(const void*, const void*));
+
+
+/**
+ * @brief Builds a new list from a snapshot.
+ *
+ * The nodes and data of the new list are allocated as a single contiguous block, as by sllist_compact().
+ * The snapshot remains valid and must still be freed with free_sllist_frozen().
+ *
+ * @param frozen A pointer to the snapshot.
+ * @return A pointer to the new list, or NULL if memory allocation fails.
+ *
+ * @usage
+ * sllist* copy = sllist_thaw(view);
+ */
+sllist* sllist_thaw(const sllist_frozen* frozen);
+
+
+/**
+ * @brief Frees a snapshot created by sllist_freeze().
+ *
+ * @param frozen A pointer to the snapshot to be freed.
+ * @usage
+ * free_sllist_frozen(view);
+ */
+void free_sllist_frozen(sllist_frozen* frozen);
+
+
+/**
+ * @brief Writes the list to a binary stream.
+ *
+ * The format is a small header (magic, version, data size, element count) followed by every
+ * payload back to back in list order, in the machine's native byte order.
+ *
+ * @param list A pointer to the singly linked list.
+ * @param fp A stream opened for binary writing.
+ * @return 0 on success, or -1 if a write fails.
+ *
+ * @usage
+ * FILE* fp = fopen("list.bin", "wb");
+ * if (sllist_save(my_list, fp) != 0) {
+ *     // Handle write failure
+ * }
+ * fclose(fp);
+ */
+int sllist_save(sllist* list, FILE* fp);
+
+
+/**
+ * @brief Reads a list written by sllist_save().
+ *
+ * All nodes and data are allocated as one contiguous block (as by sllist_compact()) and the
+ * payloads are filled with a single read.
+ *
+ * @param fp A stream opened for binary reading, positioned at the start of a saved list.
+ * @return A pointer to the new list, or NULL if the stream is malformed, truncated, or memory allocation fails.
+ *
+ * @usage
+ * FILE* fp = fopen("list.bin", "rb");
+ * sllist* my_list = sllist_load(fp);
+ * fclose(fp);
+ */
+sllist* sllist_load(FILE* fp);
+
+
+/**
+ * @brief Returns an iterator positioned at the first node of the list.
+ *
+ * Nodes up to `prefetch_distance` positions ahead are prefetched while the iterator advances.
+ * A distance of 0 disables prefetching.
+ *
+ * @param list A pointer to the singly linked list.
+ * @param prefetch_distance How many nodes ahead of the current one to prefetch.
+ * @return An iterator over the list; it is already exhausted if the list is empty.
+ *
+ * @usage
+ * sllist_iter it = sllist_iter_begin(my_list, SLLIST_PREFETCH_DISTANCE);
+ * for (int* value; (value = sllist_iter_get(&it)) != NULL; sllist_iter_next(&it)) {
+ *     sum += *value;
+ * }
+ */
+sllist_iter sllist_iter_begin(sllist* list, size_t prefetch_distance);
+
+
+/**
+ * @brief Advances the iterator to the next node.
+ *
+ * Does nothing if the iterator is already exhausted.
+ *
+ * @param it A pointer to the iterator.
+ * @usage
+ * sllist_iter_next(&it);
+ */
+void sllist_iter_next(sllist_iter* it);
+
+
+/**
+ * @brief Returns the data of the node the iterator is positioned at.
+ *
+ * @param it A pointer to the iterator.
+ * @return A pointer to the node's data, or NULL once the iterator is exhausted.
+ *
+ * @usage
+ * int* value = sllist_iter_get(&it);
+ */
+void* sllist_iter_get(sllist_iter* it);
+
+
+/**
+ * @brief Reads the counters of one operation.
+ *
+ * Counting is compiled in only when the library is built with -DSLLIST_INSTRUMENT; otherwise the
+ * operations carry no instrumentation at all and this function always fails.
+ *
+ * @param op The operation.
+ * @param out Receives the counters (zeroed on failure).
+ * @return 0 on success, or -1 if `op` is invalid or instrumentation is not compiled in.
+ *
+ * @usage
+ * sllist_op_stats st;
+ * if (sllist_op_stats_get(SLLIST_OP_INSERT_END, &st) == 0) {
+ *     printf("%.1f nodes per insert_end\n", (double)st.nodes_traversed / st.calls);
+ * }
+ */
+int sllist_op_stats_get(sllist_op op, sllist_op_stats* out);
+
+
+/**
+ * @brief Zeroes the counters of every operation.
+ *
+ * @usage
+ * sllist_op_stats_reset(); // Measure the next phase only
+ */
+void sllist_op_stats_reset(void);
+
+
+/**
+ * @brief Writes the counters of every operation that was called as a text table, followed by its
+ * non-empty latency buckets.
+ *
+ * @param fp The output stream.
+ * @usage
+ * sllist_op_stats_dump(stderr);
+ */
+void sllist_op_stats_dump(FILE* fp);
+
+
+/**
+ * @brief Returns the name of an operation, such as "insert_end".
+ *
+ * @param op The operation.
+ * @return The name, or "unknown" if `op` is invalid.
+ *
+ * @usage
+ * fprintf(stderr, "%s\n", sllist_op_name(op));
+ */
+const char* sllist_op_name(sllist_op op);
+
+
+/**
+ * @brief Installs a hook called whenever insert_end, insert_at_index, free_at_end, free_at_index or
+ * sll_len walks more than `threshold` nodes of this list.
+ *
+ * Use it to catch quadratic patterns, such as appending in a loop or indexing from the front, in
+ * production. A walk within the threshold costs one comparison; past it, the list is counted again
+ * to report its length. The hook is not inherited by clones or copies. Only calls made by the
+ * program are reported: walks the library makes for itself, such as the length taken by
+ * sllist_freeze() or sllist_copy(), never reach the hook.
+ *
+ * @param list A pointer to the singly linked list.
+ * @param threshold Largest walk that does not call the hook.
+ * @param hook The function to call, or NULL to remove the hook.
+ * @param tag Passed unchanged to the hook, for example a name identifying the list.
+ *
+ * @usage
+ * void log_slow(sllist* list, sllist_op op, size_t walked, size_t length, void* tag) {
+ *     fprintf(stderr, "%s: %s walked %zu of %zu nodes\n", (const char*)tag, sllist_op_name(op), walked, length);
+ * }
+ * sllist_set_slow_op_hook(pending, 10000, log_slow, "pending");
+ */
+void sllist_set_slow_op_hook(sllist* list, size_t threshold, sllist_slow_op_hook hook, void* tag);
+
+
 #endif // LINKEDLIST_H
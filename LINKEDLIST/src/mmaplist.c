@@ -0,0 +1,586 @@
+#define _GNU_SOURCE // For mremap
+#include <fcntl.h>
+#include <string.h> // For memcpy
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include "mmaplist.h"
+
+
+#define MML_MAGIC "SLLMMAP"
+#define MML_VERSION 1u
+#define MML_INITIAL_SIZE ((size_t)64 * 1024)
+#define MML_NIL 0 // Offset 0 holds the header, so no node ever lives there
+
+
+/**
+ * @brief Header stored at offset 0 of every list file. All offsets are relative to the file start.
+ */
+struct mml_header {
+    char magic[8];
+    uint32_t version;
+    uint32_t reserved;
+    uint64_t data_size;
+    uint64_t stride;
+    uint64_t head;
+    uint64_t tail;
+    uint64_t count;
+    uint64_t free_head;
+    uint64_t used;
+};
+
+
+/**
+ * @brief Returns the number of bytes a node with `data_size` bytes of payload occupies in the file.
+ */
+static uint64_t mml_stride(size_t data_size) {
+    return ((uint64_t)sizeof(uint64_t) + data_size + 7) & ~(uint64_t)7;
+}
+
+
+/**
+ * @brief Returns the header of a mapped list file.
+ */
+static struct mml_header* mml_header(const mmlist* list) {
+    return (struct mml_header*)list->base;
+}
+
+
+/**
+ * @brief Returns a pointer to the next-offset field of the node at `offset`.
+ */
+static uint64_t* mml_next(const mmlist* list, uint64_t offset) {
+    return (uint64_t*)(list->base + offset);
+}
+
+
+/**
+ * @brief Returns a pointer to the payload of the node at `offset`.
+ */
+static void* mml_data(const mmlist* list, uint64_t offset) {
+    return list->base + offset + sizeof(uint64_t);
+}
+
+
+/**
+ * @brief Returns non-zero if `offset` is the start of a node lying wholly inside the mapping.
+ *
+ * Readers follow `next` offsets from a file that may be corrupt or being extended by a writer, so
+ * every offset is checked before the node it names is touched.
+ */
+static int mml_valid_node(const mmlist* list, uint64_t offset) {
+    uint64_t stride = mml_header(list)->stride;
+    return offset >= sizeof(struct mml_header) && stride != 0 && offset <= list->mapped &&
+           stride <= list->mapped - offset && (offset - sizeof(struct mml_header)) % stride == 0;
+}
+
+
+/**
+ * @brief Changes the mapping to cover `size` bytes of the file. The base address may move.
+ * @return 0 on success, or -1 on failure (the old mapping stays valid).
+ */
+static int mml_remap(mmlist* list, size_t size) {
+#ifdef __linux__
+    void* base = mremap(list->base, list->mapped, size, MREMAP_MAYMOVE);
+    if (base == MAP_FAILED) {
+        return -1;
+    }
+#else
+    int prot = list->read_only ? PROT_READ : PROT_READ | PROT_WRITE;
+    void* base = mmap(NULL, size, prot, MAP_SHARED, list->fd, 0);
+    if (base == MAP_FAILED) {
+        return -1;
+    }
+    munmap(list->base, list->mapped);
+#endif
+    list->base = (unsigned char*)base;
+    list->mapped = size;
+    return 0;
+}
+
+
+/**
+ * @brief Grows the file and the mapping so that at least `needed` bytes are available.
+ * @return 0 on success, or -1 on failure.
+ */
+static int mml_reserve(mmlist* list, uint64_t needed) {
+    if (needed <= list->mapped) {
+        return 0;
+    }
+    if (needed > SIZE_MAX / 2) {
+        return -1; // Size overflow
+    }
+
+    size_t new_size = list->mapped;
+    while (new_size < needed) {
+        new_size *= 2;
+    }
+    if (ftruncate(list->fd, (off_t)new_size) != 0) {
+        return -1;
+    }
+    return mml_remap(list, new_size);
+}
+
+
+/**
+ * @brief Picks up growth made to the file by another process (read-only lists only).
+ */
+static void mml_refresh(mmlist* list) {
+    if (!list->read_only || mml_header(list)->used <= list->mapped) {
+        return;
+    }
+    struct stat st;
+    if (fstat(list->fd, &st) == 0 && (size_t)st.st_size > list->mapped) {
+        mml_remap(list, (size_t)st.st_size);
+    }
+}
+
+
+/**
+ * @brief Takes a node from the free chain or the end of the used area, growing the file if needed.
+ * @return The node's offset, or MML_NIL on failure.
+ */
+static uint64_t mml_alloc_node(mmlist* list) {
+    struct mml_header* header = mml_header(list);
+    if (header->free_head != MML_NIL) {
+        uint64_t offset = header->free_head;
+        header->free_head = *mml_next(list, offset);
+        return offset;
+    }
+
+    if (mml_reserve(list, header->used + header->stride) != 0) {
+        return MML_NIL;
+    }
+    header = mml_header(list); // The mapping may have moved
+    uint64_t offset = header->used;
+    header->used += header->stride;
+    return offset;
+}
+
+
+/**
+ * @brief Stores a copy of `data` in a new node linked after `prev` (or at the front if prev is NIL).
+ */
+static void mml_link_new(mmlist* list, void* data, uint64_t prev) {
+    uint64_t offset = mml_alloc_node(list);
+    if (offset == MML_NIL) {
+        return; // File could not grow
+    }
+
+    struct mml_header* header = mml_header(list);
+    memcpy(mml_data(list, offset), data, header->data_size);
+    if (prev == MML_NIL) {
+        *mml_next(list, offset) = header->head;
+        header->head = offset;
+    } else {
+        *mml_next(list, offset) = *mml_next(list, prev);
+        *mml_next(list, prev) = offset;
+    }
+    if (prev == header->tail) {
+        header->tail = offset;
+    }
+    header->count++;
+}
+
+
+/**
+ * @brief Unlinks the node after `prev` (or the front node if prev is NIL) and recycles it.
+ */
+static void mml_unlink(mmlist* list, uint64_t prev) {
+    struct mml_header* header = mml_header(list);
+    uint64_t victim = prev == MML_NIL ? header->head : *mml_next(list, prev);
+    uint64_t next = *mml_next(list, victim);
+
+    if (prev == MML_NIL) {
+        header->head = next;
+    } else {
+        *mml_next(list, prev) = next;
+    }
+    if (victim == header->tail) {
+        header->tail = prev;
+    }
+    *mml_next(list, victim) = header->free_head;
+    header->free_head = victim;
+    header->count--;
+}
+
+
+/**
+ * @brief Returns the offset of the node at position `index`, which must be less than the list length.
+ */
+static uint64_t mml_offset_at(const mmlist* list, size_t index) {
+    uint64_t offset = mml_header(list)->head;
+    for (size_t i = 0; i < index; i++) {
+        offset = *mml_next(list, offset);
+    }
+    return offset;
+}
+
+
+/**
+ * @brief Checks that a mapped file carries a consistent list header.
+ */
+static int mml_valid(const mmlist* list) {
+    if (list->mapped < sizeof(struct mml_header)) {
+        return 0;
+    }
+    const struct mml_header* header = mml_header(list);
+    return memcmp(header->magic, MML_MAGIC, sizeof(header->magic)) == 0 &&
+           header->version == MML_VERSION &&
+           header->stride == mml_stride((size_t)header->data_size) &&
+           header->used >= sizeof(struct mml_header) &&
+           header->head < header->used && header->tail < header->used &&
+           header->free_head < header->used;
+}
+
+
+/**
+ * @brief Opens and maps `path`; a writable open initializes the file if it is empty.
+ */
+static mmlist* mml_open(const char* path, int read_only, size_t data_size) {
+    mmlist* list = (mmlist*)malloc(sizeof(mmlist));
+    if (!list) {
+        return NULL; // Memory allocation failed
+    }
+    list->read_only = read_only;
+    list->fd = read_only ? open(path, O_RDONLY) : open(path, O_RDWR | O_CREAT, 0644);
+    if (list->fd < 0) {
+        free(list);
+        return NULL; // Cannot open file
+    }
+
+    struct stat st;
+    if (fstat(list->fd, &st) != 0) {
+        close(list->fd);
+        free(list);
+        return NULL;
+    }
+
+    int fresh = !read_only && st.st_size == 0;
+    if (fresh && ftruncate(list->fd, (off_t)MML_INITIAL_SIZE) != 0) {
+        close(list->fd);
+        free(list);
+        return NULL;
+    }
+    list->mapped = fresh ? MML_INITIAL_SIZE : (size_t)st.st_size;
+
+    int prot = read_only ? PROT_READ : PROT_READ | PROT_WRITE;
+    void* base = list->mapped ? mmap(NULL, list->mapped, prot, MAP_SHARED, list->fd, 0) : MAP_FAILED;
+    if (base == MAP_FAILED) {
+        close(list->fd);
+        free(list);
+        return NULL; // Cannot map file
+    }
+    list->base = (unsigned char*)base;
+
+    if (fresh) {
+        struct mml_header* header = mml_header(list);
+        memcpy(header->magic, MML_MAGIC, sizeof(header->magic));
+        header->version = MML_VERSION;
+        header->reserved = 0;
+        header->data_size = data_size;
+        header->stride = mml_stride(data_size);
+        header->head = MML_NIL;
+        header->tail = MML_NIL;
+        header->count = 0;
+        header->free_head = MML_NIL;
+        header->used = sizeof(struct mml_header);
+    }
+
+    if (!mml_valid(list) ||
+        (!read_only && (mml_header(list)->data_size != data_size || mml_header(list)->used > list->mapped))) {
+        mmlist_close(list);
+        return NULL; // Not a list file, or created for another element size
+    }
+    return list;
+}
+
+
+/**
+ * @brief Opens a list file for reading and writing, creating it if it does not exist.
+ *
+ * @param path Path of the list file.
+ * @param data_size The size of the data stored in each node. An existing file must have been
+ *                  created with the same size.
+ * @return A pointer to the opened list, or NULL if the file cannot be opened, mapped or is not a valid list file.
+ *
+ * @usage
+ * mmlist* my_list = mmlist_open("queue.sll", sizeof(int));
+ * if (my_list == NULL) {
+ *     // Handle failure
+ * }
+ */
+mmlist* mmlist_open(const char* path, size_t data_size) {
+    if (!path) {
+        return NULL; // Invalid parameters
+    }
+    return mml_open(path, 0, data_size);
+}
+
+
+/**
+ * @brief Opens an existing list file read-only.
+ *
+ * The mapping is shared, so several processes can open the same file without copying it.
+ * Modifying operations on a read-only list do nothing.
+ *
+ * @param path Path of the list file.
+ * @return A pointer to the opened list, or NULL if the file cannot be opened, mapped or is not a valid list file.
+ *
+ * @usage
+ * mmlist* view = mmlist_open_readonly("queue.sll");
+ */
+mmlist* mmlist_open_readonly(const char* path) {
+    if (!path) {
+        return NULL; // Invalid parameters
+    }
+    return mml_open(path, 1, 0);
+}
+
+
+/**
+ * @brief Flushes modified pages of the list file to storage.
+ *
+ * @param list A pointer to the list.
+ * @return 0 on success, or -1 on failure.
+ *
+ * @usage
+ * mmlist_sync(my_list);
+ */
+int mmlist_sync(mmlist* list) {
+    if (!list) {
+        return -1; // Invalid parameters
+    }
+    if (list->read_only) {
+        return 0;
+    }
+    return msync(list->base, list->mapped, MS_SYNC) == 0 ? 0 : -1;
+}
+
+
+/**
+ * @brief Unmaps and closes the list file and frees the list handle.
+ *
+ * Changes are left in the file; call mmlist_sync() first if they must reach storage before returning.
+ *
+ * @param list A pointer to the list.
+ * @usage
+ * mmlist_close(my_list);
+ */
+void mmlist_close(mmlist* list) {
+    if (!list) {
+        return;
+    }
+    munmap(list->base, list->mapped);
+    close(list->fd);
+    free(list);
+}
+
+
+/**
+ * @brief Inserts a new node at the front of the list.
+ *
+ * @param list A pointer to the list.
+ * @param data A pointer to the data to be stored in the new node.
+ *
+ * @usage
+ * mm_insert_front(my_list, &(int){10});
+ */
+void mm_insert_front(mmlist* list, void* data) {
+    if (!list || !data || list->read_only) {
+        return; // Invalid parameters
+    }
+    mml_link_new(list, data, MML_NIL);
+}
+
+
+/**
+ * @brief Inserts a new node at the end of the list.
+ *
+ * The file records the tail, so this operation does not traverse the list.
+ *
+ * @param list A pointer to the list.
+ * @param data A pointer to the data to be stored in the new node.
+ *
+ * @usage
+ * mm_insert_end(my_list, &(int){10});
+ */
+void mm_insert_end(mmlist* list, void* data) {
+    if (!list || !data || list->read_only) {
+        return; // Invalid parameters
+    }
+    mml_link_new(list, data, mml_header(list)->tail);
+}
+
+
+/**
+ * @brief Removes the node at the front of the list.
+ *
+ * @param list A pointer to the list.
+ * @usage
+ * mm_free_at_front(my_list);
+ */
+void mm_free_at_front(mmlist* list) {
+    if (!list || list->read_only || mml_header(list)->count == 0) {
+        return; // List is empty
+    }
+    mml_unlink(list, MML_NIL);
+}
+
+
+/**
+ * @brief Removes the node at the end of the list.
+ *
+ * @param list A pointer to the list.
+ * @usage
+ * mm_free_at_end(my_list);
+ */
+void mm_free_at_end(mmlist* list) {
+    if (!list || list->read_only || mml_header(list)->count == 0) {
+        return; // List is empty
+    }
+
+    uint64_t count = mml_header(list)->count;
+    mml_unlink(list, count == 1 ? MML_NIL : mml_offset_at(list, (size_t)count - 2));
+}
+
+
+/**
+ * @brief Removes the node at the specified index in the list.
+ *
+ * If the index is 0, the front node is removed. If the index is out of bounds, no removal is performed.
+ *
+ * @param list A pointer to the list.
+ * @param index The position of the node to be removed (0-based).
+ *
+ * @usage
+ * mm_free_at_index(my_list, 2);
+ */
+void mm_free_at_index(mmlist* list, size_t index) {
+    if (!list || list->read_only || index >= mml_header(list)->count) {
+        return; // List is empty or index out of bounds
+    }
+    mml_unlink(list, index == 0 ? MML_NIL : mml_offset_at(list, index - 1));
+}
+
+
+/**
+ * @brief Returns the length of the list.
+ *
+ * The file records the element count, so this does not traverse the list.
+ *
+ * @param list A pointer to the list.
+ * @return The number of nodes in the list.
+ *
+ * @usage
+ * size_t length = mm_len(my_list);
+ */
+size_t mm_len(mmlist* list) {
+    return list ? (size_t)mml_header(list)->count : 0;
+}
+
+
+/**
+ * @brief Prints the list.
+ * This function traverses the list and prints each node's data using the provided print function.
+ * @param list A pointer to the list.
+ * @param print_func A function pointer to a function that takes a void pointer and prints the data.
+ * @usage
+ * print_mmlist(my_list, print_int);
+ */
+void print_mmlist(mmlist* list, void (*print_func)(void*)) {
+    mml_refresh(list);
+    uint64_t offset = mml_header(list)->head;
+    while (offset != MML_NIL && mml_valid_node(list, offset)) {
+        print_func(mml_data(list, offset));
+        offset = *mml_next(list, offset);
+    }
+    printf("NULL\n");
+}
+
+
+/**
+ * @brief Returns the data of the element at the specified index.
+ *
+ * The pointer refers into the mapping and stays valid until the list is modified or closed.
+ *
+ * @param list A pointer to the list.
+ * @param index The position of the element (0-based).
+ * @return A pointer to the element's data, or NULL if the index is out of bounds.
+ *
+ * @usage
+ * int* third = mm_get(view, 2);
+ */
+void* mm_get(mmlist* list, size_t index) {
+    if (!list) {
+        return NULL; // Invalid parameters
+    }
+    mml_refresh(list);
+    if (index >= mml_header(list)->count) {
+        return NULL; // Index out of bounds
+    }
+    mmlist_iter it = { list, mml_header(list)->head };
+    for (size_t i = 0; i < index; i++) {
+        mmlist_iter_next(&it);
+    }
+    return mmlist_iter_get(&it);
+}
+
+
+/**
+ * @brief Returns an iterator positioned at the first element of the list.
+ *
+ * The iterator stays valid until the list is modified or closed. Elements are read in place
+ * from the mapping, so a service can consume a huge list without loading it.
+ *
+ * @param list A pointer to the list.
+ * @return An iterator positioned at the first element.
+ *
+ * @usage
+ * mmlist_iter it = mmlist_iter_begin(view);
+ * for (int* value; (value = mmlist_iter_get(&it)) != NULL; mmlist_iter_next(&it)) {
+ *     sum += *value;
+ * }
+ */
+mmlist_iter mmlist_iter_begin(mmlist* list) {
+    mmlist_iter it = { list, MML_NIL };
+    if (list) {
+        mml_refresh(list);
+        it.offset = mml_header(list)->head;
+    }
+    return it;
+}
+
+
+/**
+ * @brief Advances the iterator to the next element.
+ *
+ * Does nothing if the iterator is already exhausted.
+ *
+ * @param it A pointer to the iterator.
+ * @usage
+ * mmlist_iter_next(&it);
+ */
+void mmlist_iter_next(mmlist_iter* it) {
+    if (!it || it->offset == MML_NIL || !mml_valid_node(it->list, it->offset)) {
+        return; // Iterator exhausted
+    }
+    it->offset = *mml_next(it->list, it->offset);
+}
+
+
+/**
+ * @brief Returns the data of the element the iterator is positioned at.
+ *
+ * @param it A pointer to the iterator.
+ * @return A pointer to the element's data, or NULL once the iterator is exhausted.
+ *
+ * @usage
+ * int* value = mmlist_iter_get(&it);
+ */
+void* mmlist_iter_get(mmlist_iter* it) {
+    if (!it || it->offset == MML_NIL || !mml_valid_node(it->list, it->offset)) {
+        return NULL; // Iterator exhausted (or the chain leads outside the mapped nodes)
+    }
+    return mml_data(it->list, it->offset);
+}
@@ -0,0 +1,236 @@
+#ifndef MMAPLIST_H
+#define MMAPLIST_H
+
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+
+
+/**
+ * @brief Singly linked list stored in a memory-mapped file.
+ *
+ * Nodes live directly in the file and link to each other by file offset rather than by pointer,
+ * so a list can be reopened, or mapped read-only by other processes, without any deserialization.
+ * Each node holds a 64-bit next offset followed by the payload; payloads are 8-byte aligned.
+ * The file grows on demand and removed nodes are recycled by later insertions.
+ *
+ * The file uses the byte order of the machine that created it. Readers that map a file while
+ * another process is modifying it must provide their own synchronization.
+ */
+typedef struct mmlist {
+    int fd;
+    int read_only;
+    unsigned char* base;
+    size_t mapped;
+} mmlist;
+
+
+/**
+ * @brief Forward iterator over a memory-mapped list.
+ */
+typedef struct mmlist_iter {
+    const mmlist* list;
+    uint64_t offset;
+} mmlist_iter;
+
+
+/**
+ * @brief Opens a list file for reading and writing, creating it if it does not exist.
+ *
+ * @param path Path of the list file.
+ * @param data_size The size of the data stored in each node. An existing file must have been
+ *                  created with the same size.
+ * @return A pointer to the opened list, or NULL if the file cannot be opened, mapped or is not a valid list file.
+ *
+ * @usage
+ * mmlist* my_list = mmlist_open("queue.sll", sizeof(int));
+ * if (my_list == NULL) {
+ *     // Handle failure
+ * }
+ */
+mmlist* mmlist_open(const char* path, size_t data_size);
+
+
+/**
+ * @brief Opens an existing list file read-only.
+ *
+ * The mapping is shared, so several processes can open the same file without copying it.
+ * Modifying operations on a read-only list do nothing.
+ *
+ * @param path Path of the list file.
+ * @return A pointer to the opened list, or NULL if the file cannot be opened, mapped or is not a valid list file.
+ *
+ * @usage
+ * mmlist* view = mmlist_open_readonly("queue.sll");
+ */
+mmlist* mmlist_open_readonly(const char* path);
+
+
+/**
+ * @brief Flushes modified pages of the list file to storage.
+ *
+ * @param list A pointer to the list.
+ * @return 0 on success, or -1 on failure.
+ *
+ * @usage
+ * mmlist_sync(my_list);
+ */
+int mmlist_sync(mmlist* list);
+
+
+/**
+ * @brief Unmaps and closes the list file and frees the list handle.
+ *
+ * Changes are left in the file; call mmlist_sync() first if they must reach storage before returning.
+ *
+ * @param list A pointer to the list.
+ * @usage
+ * mmlist_close(my_list);
+ */
+void mmlist_close(mmlist* list);
+
+
+/**
+ * @brief Inserts a new node at the front of the list.
+ *
+ * @param list A pointer to the list.
+ * @param data A pointer to the data to be stored in the new node.
+ *
+ * @usage
+ * mm_insert_front(my_list, &(int){10});
+ */
+void mm_insert_front(mmlist* list, void* data);
+
+
+/**
+ * @brief Inserts a new node at the end of the list.
+ *
+ * The file records the tail, so this operation does not traverse the list.
+ *
+ * @param list A pointer to the list.
+ * @param data A pointer to the data to be stored in the new node.
+ *
+ * @usage
+ * mm_insert_end(my_list, &(int){10});
+ */
+void mm_insert_end(mmlist* list, void* data);
+
+
+/**
+ * @brief Removes the node at the front of the list.
+ *
+ * @param list A pointer to the list.
+ * @usage
+ * mm_free_at_front(my_list);
+ */
+void mm_free_at_front(mmlist* list);
+
+
+/**
+ * @brief Removes the node at the end of the list.
+ *
+ * @param list A pointer to the list.
+ * @usage
+ * mm_free_at_end(my_list);
+ */
+void mm_free_at_end(mmlist* list);
+
+
+/**
+ * @brief Removes the node at the specified index in the list.
+ *
+ * If the index is 0, the front node is removed. If the index is out of bounds, no removal is performed.
+ *
+ * @param list A pointer to the list.
+ * @param index The position of the node to be removed (0-based).
+ *
+ * @usage
+ * mm_free_at_index(my_list, 2);
+ */
+void mm_free_at_index(mmlist* list, size_t index);
+
+
+/**
+ * @brief Returns the length of the list.
+ *
+ * The file records the element count, so this does not traverse the list.
+ *
+ * @param list A pointer to the list.
+ * @return The number of nodes in the list.
+ *
+ * @usage
+ * size_t length = mm_len(my_list);
+ */
+size_t mm_len(mmlist* list);
+
+
+/**
+ * @brief Prints the list.
+ * This function traverses the list and prints each node's data using the provided print function.
+ * @param list A pointer to the list.
+ * @param print_func A function pointer to a function that takes a void pointer and prints the data.
+ * @usage
+ * print_mmlist(my_list, print_int);
+ */
+void print_mmlist(mmlist* list, void (*print_func)(void*));
+
+
+/**
+ * @brief Returns the data of the element at the specified index.
+ *
+ * The pointer refers into the mapping and stays valid until the list is modified or closed.
+ *
+ * @param list A pointer to the list.
+ * @param index The position of the element (0-based).
+ * @return A pointer to the element's data, or NULL if the index is out of bounds.
+ *
+ * @usage
+ * int* third = mm_get(view, 2);
+ */
+void* mm_get(mmlist* list, size_t index);
+
+
+/**
+ * @brief Returns an iterator positioned at the first element of the list.
+ *
+ * The iterator stays valid until the list is modified or closed. Elements are read in place
+ * from the mapping, so a service can consume a huge list without loading it.
+ *
+ * @param list A pointer to the list.
+ * @return An iterator positioned at the first element.
+ *
+ * @usage
+ * mmlist_iter it = mmlist_iter_begin(view);
+ * for (int* value; (value = mmlist_iter_get(&it)) != NULL; mmlist_iter_next(&it)) {
+ *     sum += *value;
+ * }
+ */
+mmlist_iter mmlist_iter_begin(mmlist* list);
+
+
+/**
+ * @brief Advances the iterator to the next element.
+ *
+ * Does nothing if the iterator is already exhausted.
+ *
+ * @param it A pointer to the iterator.
+ * @usage
+ * mmlist_iter_next(&it);
+ */
+void mmlist_iter_next(mmlist_iter* it);
+
+
+/**
+ * @brief Returns the data of the element the iterator is positioned at.
+ *
+ * @param it A pointer to the iterator.
+ * @return A pointer to the element's data, or NULL once the iterator is exhausted.
+ *
+ * @usage
+ * int* value = mmlist_iter_get(&it);
+ */
+void* mmlist_iter_get(mmlist_iter* it);
+
+
+#endif // MMAPLIST_H
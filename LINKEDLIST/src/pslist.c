@@ -0,0 +1,183 @@
+#include <string.h> // For memcpy
+#include "pslist.h"
+
+
+#if defined(__GNUC__) || defined(__clang__)
+#define PSL_REF_INC(node) __atomic_add_fetch(&(node)->refs, 1, __ATOMIC_RELAXED)
+#define PSL_REF_DEC(node) __atomic_sub_fetch(&(node)->refs, 1, __ATOMIC_ACQ_REL)
+#else
+#define PSL_REF_INC(node) (++(node)->refs)
+#define PSL_REF_DEC(node) (--(node)->refs)
+#endif
+
+
+/**
+ * @brief Allocates a node holding a copy of `data`, with one reference and no successor.
+ */
+static pslist* psl_node_alloc(const void* data, size_t data_size) {
+    pslist* node = (pslist*)malloc(sizeof(pslist) + data_size);
+    if (!node) {
+        return NULL; // Memory allocation failed
+    }
+    node->refs = 1;
+    node->next = NULL;
+    memcpy(node->data, data, data_size);
+    return node;
+}
+
+
+/**
+ * @brief Returns a new version with `data` prepended to `tail`.
+ *
+ * The new node shares `tail` and takes its own reference to it; the caller's reference to `tail`
+ * is unaffected. The caller owns the returned reference.
+ *
+ * @param tail The list to prepend to (NULL for the empty list).
+ * @param data A pointer to the data to be stored in the new node.
+ * @param data_size The size of the data.
+ * @return The new version, or NULL if memory allocation fails.
+ *
+ * @usage
+ * pslist* v1 = pslist_cons(NULL, &(int){1}, sizeof(int));
+ * pslist* v2 = pslist_cons(v1, &(int){2}, sizeof(int)); // 2 -> 1, shares v1
+ */
+pslist* pslist_cons(pslist* tail, const void* data, size_t data_size) {
+    if (!data) {
+        return NULL; // Invalid parameters
+    }
+    pslist* node = psl_node_alloc(data, data_size);
+    if (!node) {
+        return NULL; // Memory allocation failed
+    }
+    node->next = pslist_retain(tail);
+    return node;
+}
+
+
+/**
+ * @brief Takes an additional reference to a version.
+ *
+ * @param list The version to retain (may be NULL).
+ * @return `list`, for convenience.
+ *
+ * @usage
+ * pslist* snapshot = pslist_retain(current);
+ */
+pslist* pslist_retain(pslist* list) {
+    if (list) {
+        PSL_REF_INC(list);
+    }
+    return list;
+}
+
+
+/**
+ * @brief Drops a reference to a version, freeing every node no other version still uses.
+ *
+ * @param list The version to release (may be NULL).
+ * @usage
+ * pslist_release(v1);
+ */
+void pslist_release(pslist* list) {
+    // Freeing a node drops its reference to the next one; stop at the first node still shared.
+    while (list != NULL && PSL_REF_DEC(list) == 0) {
+        pslist* next = list->next;
+        free(list);
+        list = next;
+    }
+}
+
+
+/**
+ * @brief Returns the data of the first element of a version.
+ *
+ * @param list A version of the list.
+ * @return A pointer to the first element's data, or NULL if the list is empty. The data must not be modified.
+ *
+ * @usage
+ * int first = *(int*)pslist_head(v2);
+ */
+void* pslist_head(pslist* list) {
+    return list ? list->data : NULL;
+}
+
+
+/**
+ * @brief Returns the version without its first element.
+ *
+ * The result is borrowed from `list`; call pslist_retain() on it to keep it beyond `list`'s lifetime.
+ *
+ * @param list A version of the list.
+ * @return The rest of the list, or NULL if `list` has at most one element.
+ *
+ * @usage
+ * pslist* rest = pslist_retain(pslist_tail(v2)); // drop the front element
+ */
+pslist* pslist_tail(pslist* list) {
+    return list ? list->next : NULL;
+}
+
+
+/**
+ * @brief Returns the length of a version.
+ *
+ * @param list A version of the list.
+ * @return The number of elements.
+ *
+ * @usage
+ * size_t length = psl_len(v2);
+ */
+size_t psl_len(pslist* list) {
+    size_t length = 0;
+    while (list != NULL) {
+        length++;
+        list = list->next;
+    }
+    return length;
+}
+
+
+/**
+ * @brief Prints a version of the list.
+ * @param list A version of the list.
+ * @param print_func A function pointer to a function that takes a void pointer and prints the data.
+ * @usage
+ * print_pslist(v2, print_int);
+ */
+void print_pslist(pslist* list, void (*print_func)(void*)) {
+    while (list != NULL) {
+        print_func(list->data);
+        list = list->next;
+    }
+    printf("NULL\n");
+}
+
+
+/**
+ * @brief Builds a persistent list with the same elements as a singly linked list.
+ *
+ * @param list A pointer to the singly linked list.
+ * @return The new version (NULL for an empty list or if memory allocation fails).
+ *
+ * @usage
+ * pslist* config = pslist_from_sllist(loaded_entries);
+ */
+pslist* pslist_from_sllist(sllist* list) {
+    if (!list) {
+        return NULL; // Invalid parameters
+    }
+
+    pslist* head = NULL;
+    pslist** link = &head;
+    sllist_iter it = sllist_iter_begin(list, SLLIST_PREFETCH_DISTANCE);
+    for (void* data; (data = sllist_iter_get(&it)) != NULL; sllist_iter_next(&it)) {
+        pslist* node = psl_node_alloc(data, list->data_size);
+        if (!node) {
+            pslist_release(head);
+            return NULL; // Memory allocation failed
+        }
+        *link = node;
+        link = &node->next;
+    }
+    return head;
+}
@@ -0,0 +1,127 @@
+#ifndef PSLIST_H
+#define PSLIST_H
+
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stddef.h>
+#include "linkedlist.h"
+
+
+/**
+ * @brief Node of a persistent (immutable) singly linked list.
+ *
+ * A list version is a pointer to its first node, and NULL is the empty list. Nodes are never modified
+ * after creation, so new versions share their tail with older ones: prepending is O(1) regardless
+ * of length. Each node counts the references to it (from list handles and from other nodes) and is
+ * freed when the last one is released. Reference counts are updated atomically, so versions may be
+ * shared between threads.
+ */
+typedef struct pslist {
+    size_t refs;
+    struct pslist* next;
+    _Alignas(max_align_t) unsigned char data[];
+} pslist;
+
+
+/**
+ * @brief Returns a new version with `data` prepended to `tail`.
+ *
+ * The new node shares `tail` and takes its own reference to it; the caller's reference to `tail`
+ * is unaffected. The caller owns the returned reference.
+ *
+ * @param tail The list to prepend to (NULL for the empty list).
+ * @param data A pointer to the data to be stored in the new node.
+ * @param data_size The size of the data.
+ * @return The new version, or NULL if memory allocation fails.
+ *
+ * @usage
+ * pslist* v1 = pslist_cons(NULL, &(int){1}, sizeof(int));
+ * pslist* v2 = pslist_cons(v1, &(int){2}, sizeof(int)); // 2 -> 1, shares v1
+ */
+pslist* pslist_cons(pslist* tail, const void* data, size_t data_size);
+
+
+/**
+ * @brief Takes an additional reference to a version.
+ *
+ * @param list The version to retain (may be NULL).
+ * @return `list`, for convenience.
+ *
+ * @usage
+ * pslist* snapshot = pslist_retain(current);
+ */
+pslist* pslist_retain(pslist* list);
+
+
+/**
+ * @brief Drops a reference to a version, freeing every node no other version still uses.
+ *
+ * @param list The version to release (may be NULL).
+ * @usage
+ * pslist_release(v1);
+ */
+void pslist_release(pslist* list);
+
+
+/**
+ * @brief Returns the data of the first element of a version.
+ *
+ * @param list A version of the list.
+ * @return A pointer to the first element's data, or NULL if the list is empty. The data must not be modified.
+ *
+ * @usage
+ * int first = *(int*)pslist_head(v2);
+ */
+void* pslist_head(pslist* list);
+
+
+/**
+ * @brief Returns the version without its first element.
+ *
+ * The result is borrowed from `list`; call pslist_retain() on it to keep it beyond `list`'s lifetime.
+ *
+ * @param list A version of the list.
+ * @return The rest of the list, or NULL if `list` has at most one element.
+ *
+ * @usage
+ * pslist* rest = pslist_retain(pslist_tail(v2)); // drop the front element
+ */
+pslist* pslist_tail(pslist* list);
+
+
+/**
+ * @brief Returns the length of a version.
+ *
+ * @param list A version of the list.
+ * @return The number of elements.
+ *
+ * @usage
+ * size_t length = psl_len(v2);
+ */
+size_t psl_len(pslist* list);
+
+
+/**
+ * @brief Prints a version of the list.
+ * @param list A version of the list.
+ * @param print_func A function pointer to a function that takes a void pointer and prints the data.
+ * @usage
+ * print_pslist(v2, print_int);
+ */
+void print_pslist(pslist* list, void (*print_func)(void*));
+
+
+/**
+ * @brief Builds a persistent list with the same elements as a singly linked list.
+ *
+ * @param list A pointer to the singly linked list.
+ * @return The new version (NULL for an empty list or if memory allocation fails).
+ *
+ * @usage
+ * pslist* config = pslist_from_sllist(loaded_entries);
+ */
+pslist* pslist_from_sllist(sllist* list);
+
+
+#endif // PSLIST_H
@@ -0,0 +1,489 @@
+#define _POSIX_C_SOURCE 200809L // For shm_open, robust mutexes
+#include <errno.h>
+#include <fcntl.h>
+#include <pthread.h>
+#include <stdint.h>
+#include <stdlib.h> // For calloc, free
+#include <string.h> // For memcpy, memcmp
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include "shmlist.h"
+
+
+#define SHM_MAGIC "SLLSHM"
+#define SHM_VERSION 1u
+#define SHM_NIL 0 // Offset 0 holds the header, so no node ever lives there
+
+
+/**
+ * @brief Header at the start of the segment. All offsets are relative to the segment start.
+ */
+struct shm_header {
+    char magic[8];
+    uint32_t version;
+    uint32_t reserved;
+    pthread_mutex_t lock;
+    uint64_t data_size;
+    uint64_t stride;
+    uint64_t size;
+    uint64_t nodes_offset;
+    uint64_t head;
+    uint64_t tail;
+    uint64_t count;
+    uint64_t free_head;
+    uint64_t used;
+};
+
+
+/**
+ * @brief Returns the header of a mapped segment.
+ */
+static struct shm_header* shm_header(const shmlist* list) {
+    return (struct shm_header*)list->base;
+}
+
+
+/**
+ * @brief Returns a pointer to the next-offset field of the node at `offset`.
+ */
+static uint64_t* shm_next(const shmlist* list, uint64_t offset) {
+    return (uint64_t*)(list->base + offset);
+}
+
+
+/**
+ * @brief Returns a pointer to the payload of the node at `offset`.
+ */
+static void* shm_data(const shmlist* list, uint64_t offset) {
+    return list->base + offset + sizeof(uint64_t);
+}
+
+
+/**
+ * @brief Rebuilds the chains of a segment whose previous lock owner died mid-operation.
+ *
+ * The owner may have left a node in neither chain (taken from the free chain but not yet linked,
+ * or unlinked but not yet freed), a stale tail, or a wrong count. The list chain is walked from the
+ * head, cut at the first link that is not a valid node or that loops, and taken as the truth; every
+ * other node below `used` becomes free again.
+ */
+static void shm_repair(shmlist* list) {
+    struct shm_header* header = shm_header(list);
+    uint64_t slots = (header->used - header->nodes_offset) / header->stride;
+    unsigned char* linked = (unsigned char*)calloc(slots / 8 + 1, 1);
+
+    uint64_t* link = &header->head;
+    uint64_t tail = SHM_NIL;
+    uint64_t count = 0;
+    while (*link != SHM_NIL) {
+        uint64_t offset = *link;
+        uint64_t slot = (offset - header->nodes_offset) / header->stride;
+        if (offset < header->nodes_offset || offset >= header->used ||
+            (offset - header->nodes_offset) % header->stride != 0 ||
+            (linked && (linked[slot / 8] & (1u << (slot % 8))))) {
+            *link = SHM_NIL; // Not a node, or a cycle: the chain ends here
+            break;
+        }
+        if (linked) {
+            linked[slot / 8] |= (unsigned char)(1u << (slot % 8));
+        }
+        tail = offset;
+        count++;
+        link = shm_next(list, offset);
+    }
+    header->tail = tail;
+    header->count = count;
+
+    if (!linked) {
+        return; // Memory allocation failed; the list is consistent, nodes off both chains stay lost
+    }
+    header->free_head = SHM_NIL;
+    for (uint64_t slot = slots; slot-- > 0;) {
+        if (!(linked[slot / 8] & (1u << (slot % 8)))) {
+            uint64_t offset = header->nodes_offset + slot * header->stride;
+            *shm_next(list, offset) = header->free_head;
+            header->free_head = offset;
+        }
+    }
+    free(linked);
+}
+
+
+/**
+ * @brief Takes the list lock, recovering it if its previous owner died while holding it.
+ *
+ * @return 0 once the lock is held, or the error from pthread_mutex_lock() (such as ENOTRECOVERABLE
+ *         after a failed recovery) if it is not; the caller must then leave the list alone.
+ */
+static int shm_lock(shmlist* list) {
+    pthread_mutex_t* lock = &shm_header(list)->lock;
+    int error = pthread_mutex_lock(lock);
+    if (error == EOWNERDEAD) {
+        shm_repair(list);
+        error = pthread_mutex_consistent(lock);
+        if (error != 0) {
+            pthread_mutex_unlock(lock); // Leaves the lock unrecoverable for everyone
+        }
+    }
+    return error;
+}
+
+
+/**
+ * @brief Releases the list lock.
+ */
+static void shm_unlock(shmlist* list) {
+    pthread_mutex_unlock(&shm_header(list)->lock);
+}
+
+
+/**
+ * @brief Stores a copy of `data` in a free node linked at the front or the end. Caller holds the lock.
+ */
+static int shm_link_new(shmlist* list, void* data, int at_end) {
+    struct shm_header* header = shm_header(list);
+    uint64_t offset;
+    if (header->free_head != SHM_NIL) {
+        offset = header->free_head;
+        header->free_head = *shm_next(list, offset);
+    } else if (header->used + header->stride <= header->size) {
+        offset = header->used;
+        header->used += header->stride;
+    } else {
+        return -1; // List is full
+    }
+
+    memcpy(shm_data(list, offset), data, header->data_size);
+    *shm_next(list, offset) = SHM_NIL;
+    if (header->head == SHM_NIL) {
+        header->head = offset;
+        header->tail = offset;
+    } else if (at_end) {
+        *shm_next(list, header->tail) = offset;
+        header->tail = offset;
+    } else {
+        *shm_next(list, offset) = header->head;
+        header->head = offset;
+    }
+    header->count++;
+    return 0;
+}
+
+
+/**
+ * @brief Unlinks the front node and returns it to the free chain. Caller holds the lock.
+ */
+static void shm_unlink_front(shmlist* list) {
+    struct shm_header* header = shm_header(list);
+    uint64_t victim = header->head;
+    header->head = *shm_next(list, victim);
+    if (header->head == SHM_NIL) {
+        header->tail = SHM_NIL;
+    }
+    *shm_next(list, victim) = header->free_head;
+    header->free_head = victim;
+    header->count--;
+}
+
+
+/**
+ * @brief Maps `size` bytes of the segment open on `fd` into a new handle.
+ */
+static shmlist* shm_map(int fd, size_t size) {
+    shmlist* list = (shmlist*)malloc(sizeof(shmlist));
+    if (!list) {
+        return NULL; // Memory allocation failed
+    }
+    void* base = mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    if (base == MAP_FAILED) {
+        free(list);
+        return NULL; // Cannot map segment
+    }
+    list->base = (unsigned char*)base;
+    list->mapped = size;
+    return list;
+}
+
+
+/**
+ * @brief Creates a new shared memory segment holding an empty list.
+ *
+ * Fails if a segment with the same name already exists.
+ *
+ * @param name Name of the segment, of the form "/name".
+ * @param data_size The size of the data stored in each node.
+ * @param capacity The maximum number of nodes the list can hold.
+ * @return A pointer to the list, or NULL if the segment cannot be created or mapped.
+ *
+ * @usage
+ * shmlist* queue = shmlist_create("/ingest", sizeof(record), 1 << 20);
+ * if (queue == NULL) {
+ *     // Handle failure
+ * }
+ */
+shmlist* shmlist_create(const char* name, size_t data_size, size_t capacity) {
+    if (!name || capacity == 0) {
+        return NULL; // Invalid parameters
+    }
+
+    uint64_t stride = ((uint64_t)sizeof(uint64_t) + data_size + 7) & ~(uint64_t)7;
+    uint64_t nodes_offset = (sizeof(struct shm_header) + 7) & ~(uint64_t)7;
+    if (capacity > (SIZE_MAX - nodes_offset) / stride) {
+        return NULL; // Size overflow
+    }
+    size_t size = (size_t)(nodes_offset + capacity * stride);
+
+    int fd = shm_open(name, O_RDWR | O_CREAT | O_EXCL, 0600);
+    if (fd < 0) {
+        return NULL; // Cannot create segment
+    }
+    shmlist* list = ftruncate(fd, (off_t)size) == 0 ? shm_map(fd, size) : NULL;
+    close(fd);
+    if (!list) {
+        shm_unlink(name);
+        return NULL;
+    }
+
+    struct shm_header* header = shm_header(list);
+    pthread_mutexattr_t attr;
+    pthread_mutexattr_init(&attr);
+    pthread_mutexattr_setpshared(&attr, PTHREAD_PROCESS_SHARED);
+    pthread_mutexattr_setrobust(&attr, PTHREAD_MUTEX_ROBUST);
+    int rc = pthread_mutex_init(&header->lock, &attr);
+    pthread_mutexattr_destroy(&attr);
+    if (rc != 0) {
+        shmlist_close(list);
+        shm_unlink(name);
+        return NULL;
+    }
+
+    header->version = SHM_VERSION;
+    header->reserved = 0;
+    header->data_size = data_size;
+    header->stride = stride;
+    header->size = size;
+    header->nodes_offset = nodes_offset;
+    header->head = SHM_NIL;
+    header->tail = SHM_NIL;
+    header->count = 0;
+    header->free_head = SHM_NIL;
+    header->used = nodes_offset;
+
+    // Publish the magic last so that openers never see a half-initialized header.
+    __sync_synchronize();
+    memcpy(header->magic, SHM_MAGIC, sizeof(SHM_MAGIC));
+    return list;
+}
+
+
+/**
+ * @brief Attaches to a list created by shmlist_create(), possibly in another process.
+ *
+ * @param name Name of the segment.
+ * @return A pointer to the list, or NULL if the segment does not exist or is not a list.
+ *
+ * @usage
+ * shmlist* queue = shmlist_open("/ingest");
+ */
+shmlist* shmlist_open(const char* name) {
+    if (!name) {
+        return NULL; // Invalid parameters
+    }
+
+    int fd = shm_open(name, O_RDWR, 0);
+    if (fd < 0) {
+        return NULL; // No such segment
+    }
+    struct stat st;
+    shmlist* list = NULL;
+    if (fstat(fd, &st) == 0 && (size_t)st.st_size >= sizeof(struct shm_header)) {
+        list = shm_map(fd, (size_t)st.st_size);
+    }
+    close(fd);
+    if (!list) {
+        return NULL;
+    }
+
+    const struct shm_header* header = shm_header(list);
+    if (memcmp(header->magic, SHM_MAGIC, sizeof(SHM_MAGIC)) != 0 ||
+        header->version != SHM_VERSION || header->size != list->mapped) {
+        shmlist_close(list);
+        return NULL; // Not a list segment, or not initialized yet
+    }
+    return list;
+}
+
+
+/**
+ * @brief Detaches from the list and frees the handle. The segment itself stays alive.
+ *
+ * @param list A pointer to the list.
+ * @usage
+ * shmlist_close(queue);
+ */
+void shmlist_close(shmlist* list) {
+    if (!list) {
+        return;
+    }
+    munmap(list->base, list->mapped);
+    free(list);
+}
+
+
+/**
+ * @brief Removes the named segment; it is destroyed once every process has closed it.
+ *
+ * @param name Name of the segment.
+ * @return 0 on success, or -1 on failure.
+ *
+ * @usage
+ * shmlist_unlink("/ingest");
+ */
+int shmlist_unlink(const char* name) {
+    if (!name) {
+        return -1; // Invalid parameters
+    }
+    return shm_unlink(name) == 0 ? 0 : -1;
+}
+
+
+/**
+ * @brief Inserts a new node at the front of the list.
+ *
+ * @param list A pointer to the list.
+ * @param data A pointer to the data to be stored in the new node.
+ * @return 0 on success, or -1 if the list is full or its lock cannot be taken.
+ *
+ * @usage
+ * shm_insert_front(queue, &item);
+ */
+int shm_insert_front(shmlist* list, void* data) {
+    if (!list || !data) {
+        return -1; // Invalid parameters
+    }
+    if (shm_lock(list) != 0) {
+        return -1; // Lock unavailable
+    }
+    int result = shm_link_new(list, data, 0);
+    shm_unlock(list);
+    return result;
+}
+
+
+/**
+ * @brief Inserts a new node at the end of the list.
+ *
+ * @param list A pointer to the list.
+ * @param data A pointer to the data to be stored in the new node.
+ * @return 0 on success, or -1 if the list is full or its lock cannot be taken.
+ *
+ * @usage
+ * shm_insert_end(queue, &item);
+ */
+int shm_insert_end(shmlist* list, void* data) {
+    if (!list || !data) {
+        return -1; // Invalid parameters
+    }
+    if (shm_lock(list) != 0) {
+        return -1; // Lock unavailable
+    }
+    int result = shm_link_new(list, data, 1);
+    shm_unlock(list);
+    return result;
+}
+
+
+/**
+ * @brief Removes the node at the front of the list. Does nothing if the lock cannot be taken.
+ *
+ * @param list A pointer to the list.
+ * @usage
+ * shm_free_at_front(queue);
+ */
+void shm_free_at_front(shmlist* list) {
+    if (!list) {
+        return; // Invalid parameters
+    }
+    if (shm_lock(list) != 0) {
+        return; // Lock unavailable
+    }
+    if (shm_header(list)->head != SHM_NIL) {
+        shm_unlink_front(list);
+    }
+    shm_unlock(list);
+}
+
+
+/**
+ * @brief Copies the front element into `out` and removes it, as one atomic step.
+ *
+ * @param list A pointer to the list.
+ * @param out Buffer of at least `data_size` bytes receiving the element.
+ * @return 1 if an element was taken, or 0 if the list was empty or its lock cannot be taken.
+ *
+ * @usage
+ * record item;
+ * while (shm_take_front(queue, &item)) {
+ *     process(&item);
+ * }
+ */
+int shm_take_front(shmlist* list, void* out) {
+    if (!list || !out) {
+        return 0; // Invalid parameters
+    }
+    if (shm_lock(list) != 0) {
+        return 0; // Lock unavailable
+    }
+    struct shm_header* header = shm_header(list);
+    int taken = header->head != SHM_NIL;
+    if (taken) {
+        memcpy(out, shm_data(list, header->head), header->data_size);
+        shm_unlink_front(list);
+    }
+    shm_unlock(list);
+    return taken;
+}
+
+
+/**
+ * @brief Returns the length of the list.
+ *
+ * @param list A pointer to the list.
+ * @return The number of nodes in the list, or 0 if its lock cannot be taken.
+ *
+ * @usage
+ * size_t length = shm_len(queue);
+ */
+size_t shm_len(shmlist* list) {
+    if (!list) {
+        return 0;
+    }
+    if (shm_lock(list) != 0) {
+        return 0; // Lock unavailable
+    }
+    size_t count = (size_t)shm_header(list)->count;
+    shm_unlock(list);
+    return count;
+}
+
+
+/**
+ * @brief Prints the list while holding its lock. Prints nothing if the lock cannot be taken.
+ * @param list A pointer to the list.
+ * @param print_func A function pointer to a function that takes a void pointer and prints the data.
+ * @usage
+ * print_shmlist(queue, print_int);
+ */
+void print_shmlist(shmlist* list, void (*print_func)(void*)) {
+    if (shm_lock(list) != 0) {
+        return; // Lock unavailable
+    }
+    uint64_t offset = shm_header(list)->head;
+    while (offset != SHM_NIL) {
+        print_func(shm_data(list, offset));
+        offset = *shm_next(list, offset);
+    }
+    shm_unlock(list);
+    printf("NULL\n");
+}
@@ -0,0 +1,151 @@
+#ifndef SHMLIST_H
+#define SHMLIST_H
+
+
+#include <stdio.h>
+#include <stdlib.h>
+
+
+/**
+ * @brief Singly linked list whose nodes live in a POSIX shared memory segment.
+ *
+ * Nodes link by offset within the segment, so every process that maps it sees the same list at
+ * whatever address the mapping lands on. All operations take a process-shared mutex stored in the
+ * segment, which lets a producer process insert while consumer processes remove, with no copies
+ * through pipes or sockets. The segment holds a fixed number of nodes chosen at creation. If a
+ * process dies holding the mutex, the next locker repairs the chains before using them.
+ */
+typedef struct shmlist {
+    unsigned char* base;
+    size_t mapped;
+} shmlist;
+
+
+/**
+ * @brief Creates a new shared memory segment holding an empty list.
+ *
+ * Fails if a segment with the same name already exists.
+ *
+ * @param name Name of the segment, of the form "/name".
+ * @param data_size The size of the data stored in each node.
+ * @param capacity The maximum number of nodes the list can hold.
+ * @return A pointer to the list, or NULL if the segment cannot be created or mapped.
+ *
+ * @usage
+ * shmlist* queue = shmlist_create("/ingest", sizeof(record), 1 << 20);
+ * if (queue == NULL) {
+ *     // Handle failure
+ * }
+ */
+shmlist* shmlist_create(const char* name, size_t data_size, size_t capacity);
+
+
+/**
+ * @brief Attaches to a list created by shmlist_create(), possibly in another process.
+ *
+ * @param name Name of the segment.
+ * @return A pointer to the list, or NULL if the segment does not exist or is not a list.
+ *
+ * @usage
+ * shmlist* queue = shmlist_open("/ingest");
+ */
+shmlist* shmlist_open(const char* name);
+
+
+/**
+ * @brief Detaches from the list and frees the handle. The segment itself stays alive.
+ *
+ * @param list A pointer to the list.
+ * @usage
+ * shmlist_close(queue);
+ */
+void shmlist_close(shmlist* list);
+
+
+/**
+ * @brief Removes the named segment; it is destroyed once every process has closed it.
+ *
+ * @param name Name of the segment.
+ * @return 0 on success, or -1 on failure.
+ *
+ * @usage
+ * shmlist_unlink("/ingest");
+ */
+int shmlist_unlink(const char* name);
+
+
+/**
+ * @brief Inserts a new node at the front of the list.
+ *
+ * @param list A pointer to the list.
+ * @param data A pointer to the data to be stored in the new node.
+ * @return 0 on success, or -1 if the list is full or its lock cannot be taken.
+ *
+ * @usage
+ * shm_insert_front(queue, &item);
+ */
+int shm_insert_front(shmlist* list, void* data);
+
+
+/**
+ * @brief Inserts a new node at the end of the list.
+ *
+ * @param list A pointer to the list.
+ * @param data A pointer to the data to be stored in the new node.
+ * @return 0 on success, or -1 if the list is full or its lock cannot be taken.
+ *
+ * @usage
+ * shm_insert_end(queue, &item);
+ */
+int shm_insert_end(shmlist* list, void* data);
+
+
+/**
+ * @brief Removes the node at the front of the list. Does nothing if the lock cannot be taken.
+ *
+ * @param list A pointer to the list.
+ * @usage
+ * shm_free_at_front(queue);
+ */
+void shm_free_at_front(shmlist* list);
+
+
+/**
+ * @brief Copies the front element into `out` and removes it, as one atomic step.
+ *
+ * @param list A pointer to the list.
+ * @param out Buffer of at least `data_size` bytes receiving the element.
+ * @return 1 if an element was taken, or 0 if the list was empty or its lock cannot be taken.
+ *
+ * @usage
+ * record item;
+ * while (shm_take_front(queue, &item)) {
+ *     process(&item);
+ * }
+ */
+int shm_take_front(shmlist* list, void* out);
+
+
+/**
+ * @brief Returns the length of the list.
+ *
+ * @param list A pointer to the list.
+ * @return The number of nodes in the list, or 0 if its lock cannot be taken.
+ *
+ * @usage
+ * size_t length = shm_len(queue);
+ */
+size_t shm_len(shmlist* list);
+
+
+/**
+ * @brief Prints the list while holding its lock. Prints nothing if the lock cannot be taken.
+ * @param list A pointer to the list.
+ * @param print_func A function pointer to a function that takes a void pointer and prints the data.
+ * @usage
+ * print_shmlist(queue, print_int);
+ */
+void print_shmlist(shmlist* list, void (*print_func)(void*));
+
+
+#endif // SHMLIST_H
@@ -0,0 +1,391 @@
+#include <string.h> // For memcpy
+#include "soalist.h"
+
+
+#define SOA_INITIAL_CAPACITY 16
+
+
+/**
+ * @brief Returns a pointer to the payload stored in `slot`.
+ */
+static unsigned char* soa_slot_data(const soalist* list, uint32_t slot) {
+    return list->data + (size_t)slot * list->data_size;
+}
+
+
+/**
+ * @brief Makes room for at least one more slot, growing both arrays.
+ * @return Non-zero on success.
+ */
+static int soa_reserve(soalist* list) {
+    if (list->count < list->capacity) {
+        return 1;
+    }
+    if (list->capacity == SOALIST_NIL) {
+        return 0; // Index space exhausted
+    }
+
+    uint32_t new_capacity = SOA_INITIAL_CAPACITY;
+    if (list->capacity != 0) {
+        new_capacity = list->capacity > SOALIST_NIL / 2 ? SOALIST_NIL : list->capacity * 2;
+    }
+    if (list->data_size != 0 && new_capacity > SIZE_MAX / list->data_size) {
+        return 0; // Size overflow
+    }
+
+    uint32_t* next = (uint32_t*)realloc(list->next, (size_t)new_capacity * sizeof(uint32_t));
+    if (!next) {
+        return 0; // Memory allocation failed
+    }
+    list->next = next;
+
+    uint32_t* prev = (uint32_t*)realloc(list->prev, (size_t)new_capacity * sizeof(uint32_t));
+    if (!prev) {
+        return 0; // Memory allocation failed; the larger link array is kept
+    }
+    list->prev = prev;
+
+    // Keep the payload allocation non-empty so realloc never sees a zero size.
+    size_t data_bytes = list->data_size ? (size_t)new_capacity * list->data_size : 1;
+    unsigned char* data = (unsigned char*)realloc(list->data, data_bytes);
+    if (!data) {
+        return 0; // Memory allocation failed; the larger link arrays are kept
+    }
+    list->data = data;
+    list->capacity = new_capacity;
+    return 1;
+}
+
+
+/**
+ * @brief Stores a copy of `data` in a new slot and links it after `prev` (or at the front if prev is NIL).
+ */
+static void soa_link_new(soalist* list, void* data, uint32_t prev) {
+    if (!soa_reserve(list)) {
+        return; // Memory allocation failed
+    }
+
+    uint32_t slot = list->count++;
+    memcpy(soa_slot_data(list, slot), data, list->data_size);
+
+    if (prev == SOALIST_NIL) {
+        list->next[slot] = list->head;
+        list->head = slot;
+    } else {
+        list->next[slot] = list->next[prev];
+        list->next[prev] = slot;
+    }
+    list->prev[slot] = prev;
+    if (list->next[slot] != SOALIST_NIL) {
+        list->prev[list->next[slot]] = slot;
+    }
+    if (prev == list->tail) {
+        list->tail = slot;
+    }
+}
+
+
+/**
+ * @brief Unlinks the node after `prev` (or the front node if prev is NIL) and refills its slot.
+ *
+ * The last stored slot is moved into the freed one so that the payload array stays dense; the
+ * back links locate its neighbours, so this takes constant time.
+ */
+static void soa_unlink(soalist* list, uint32_t prev) {
+    uint32_t victim = prev == SOALIST_NIL ? list->head : list->next[prev];
+
+    if (prev == SOALIST_NIL) {
+        list->head = list->next[victim];
+    } else {
+        list->next[prev] = list->next[victim];
+    }
+    if (list->next[victim] != SOALIST_NIL) {
+        list->prev[list->next[victim]] = prev;
+    }
+    if (victim == list->tail) {
+        list->tail = prev;
+    }
+
+    uint32_t last = --list->count;
+    if (victim == last) {
+        return;
+    }
+
+    memcpy(soa_slot_data(list, victim), soa_slot_data(list, last), list->data_size);
+    list->next[victim] = list->next[last];
+    list->prev[victim] = list->prev[last];
+    if (list->prev[victim] == SOALIST_NIL) {
+        list->head = victim;
+    } else {
+        list->next[list->prev[victim]] = victim;
+    }
+    if (list->next[victim] != SOALIST_NIL) {
+        list->prev[list->next[victim]] = victim;
+    }
+    if (list->tail == last) {
+        list->tail = victim;
+    }
+}
+
+
+/**
+ * @brief Returns the slot at position `index`, which must be less than the list length.
+ */
+static uint32_t soa_slot_at(const soalist* list, size_t index) {
+    uint32_t slot = list->head;
+    for (size_t i = 0; i < index; i++) {
+        slot = list->next[slot];
+    }
+    return slot;
+}
+
+
+/**
+ * @brief Creates a new struct-of-arrays list.
+ *
+ * @param data_size The size of the data to be stored in each node.
+ * @return A pointer to the newly created list, or NULL if memory allocation fails.
+ *
+ * @usage
+ * soalist* my_list = soalist_create(sizeof(double));
+ * if (my_list == NULL) {
+ *     // Handle memory allocation failure
+ * }
+ */
+soalist* soalist_create(size_t data_size) {
+    soalist* list = (soalist*)malloc(sizeof(soalist));
+    if (!list) {
+        return NULL; // Memory allocation failed
+    }
+    list->next = NULL;
+    list->prev = NULL;
+    list->data = NULL;
+    list->data_size = data_size;
+    list->capacity = 0;
+    list->count = 0;
+    list->head = SOALIST_NIL;
+    list->tail = SOALIST_NIL;
+    return list;
+}
+
+
+/**
+ * @brief Inserts a new node at the front of the list.
+ *
+ * @param list A pointer to the list.
+ * @param data A pointer to the data to be stored in the new node.
+ *
+ * @usage
+ * soa_insert_front(my_list, &(double){1.5});
+ */
+void soa_insert_front(soalist* list, void* data) {
+    if (!list || !data) {
+        return; // Invalid parameters
+    }
+    soa_link_new(list, data, SOALIST_NIL);
+}
+
+
+/**
+ * @brief Inserts a new node at the end of the list.
+ *
+ * The list tracks its tail, so this operation does not traverse the list.
+ *
+ * @param list A pointer to the list.
+ * @param data A pointer to the data to be stored in the new node.
+ *
+ * @usage
+ * soa_insert_end(my_list, &(double){1.5});
+ */
+void soa_insert_end(soalist* list, void* data) {
+    if (!list || !data) {
+        return; // Invalid parameters
+    }
+    soa_link_new(list, data, list->tail);
+}
+
+
+/**
+ * @brief Inserts a new node at the specified index in the list.
+ *
+ * If the index is 0, the node is inserted at the front. If the index is equal to the length of the list,
+ * the node is inserted at the end. If the index is out of bounds, no insertion is performed.
+ *
+ * @param list A pointer to the list.
+ * @param data A pointer to the data to be stored in the new node.
+ * @param index The position at which to insert the new node (0-based).
+ *
+ * @usage
+ * soa_insert_at_index(my_list, &(double){1.5}, 2);
+ */
+void soa_insert_at_index(soalist* list, void* data, size_t index) {
+    if (!list || !data) {
+        return; // Invalid parameters
+    }
+    if (index > list->count) {
+        return; // Index out of bounds
+    }
+
+    if (index == 0) {
+        soa_link_new(list, data, SOALIST_NIL);
+    } else if (index == list->count) {
+        soa_link_new(list, data, list->tail);
+    } else {
+        soa_link_new(list, data, soa_slot_at(list, index - 1));
+    }
+}
+
+
+/**
+ * @brief Frees the entire list, its arrays and the list structure.
+ *
+ * @param list A pointer to the list to be freed.
+ * @usage
+ * free_soalist(my_list);
+ */
+void free_soalist(soalist* list) {
+    if (!list) {
+        return;
+    }
+    free(list->next);
+    free(list->prev);
+    free(list->data);
+    free(list);
+}
+
+
+/**
+ * @brief Removes the node at the front of the list.
+ *
+ * Keeping the payload array dense may relocate the last stored slot, which takes constant time.
+ *
+ * @param list A pointer to the list.
+ * @usage
+ * soa_free_at_front(my_list);
+ */
+void soa_free_at_front(soalist* list) {
+    if (!list || list->count == 0) {
+        return; // List is empty
+    }
+    soa_unlink(list, SOALIST_NIL);
+}
+
+
+/**
+ * @brief Removes the node at the end of the list.
+ *
+ * The list keeps back links, so this operation does not traverse the list.
+ *
+ * @param list A pointer to the list.
+ * @usage
+ * soa_free_at_end(my_list);
+ */
+void soa_free_at_end(soalist* list) {
+    if (!list || list->count == 0) {
+        return; // List is empty
+    }
+
+    soa_unlink(list, list->prev[list->tail]);
+}
+
+
+/**
+ * @brief Removes the node at the specified index in the list.
+ *
+ * If the index is 0, the front node is removed. If the index is out of bounds, no removal is performed.
+ *
+ * @param list A pointer to the list.
+ * @param index The position of the node to be removed (0-based).
+ *
+ * @usage
+ * soa_free_at_index(my_list, 2);
+ */
+void soa_free_at_index(soalist* list, size_t index) {
+    if (!list || index >= list->count) {
+        return; // List is empty or index out of bounds
+    }
+
+    if (index == 0) {
+        soa_unlink(list, SOALIST_NIL);
+        return;
+    }
+    soa_unlink(list, soa_slot_at(list, index - 1));
+}
+
+
+/**
+ * @brief Returns the length of the list.
+ *
+ * @param list A pointer to the list.
+ * @return The number of nodes in the list.
+ *
+ * @usage
+ * size_t length = soa_len(my_list);
+ */
+size_t soa_len(soalist* list) {
+    return list ? list->count : 0;
+}
+
+
+/**
+ * @brief Prints the list in list order.
+ * This function traverses the list and prints each node's data using the provided print function.
+ * @param list A pointer to the list.
+ * @param print_func A function pointer to a function that takes a void pointer and prints the data.
+ * @usage
+ * print_soalist(my_list, print_double);
+ */
+void print_soalist(soalist* list, void (*print_func)(void*)) {
+    uint32_t slot = list->head;
+    while (slot != SOALIST_NIL) {
+        print_func(soa_slot_data(list, slot));
+        slot = list->next[slot];
+    }
+    printf("NULL\n");
+}
+
+
+/**
+ * @brief Returns the contiguous payload array.
+ *
+ * The array holds soa_len(list) elements of `data_size` bytes in storage order. It is valid
+ * until the next insertion or removal.
+ *
+ * @param list A pointer to the list.
+ * @return A pointer to the first payload, or NULL if the list is empty.
+ *
+ * @usage
+ * const double* values = soa_payloads(my_list);
+ * double sum = 0;
+ * for (size_t i = 0; i < soa_len(my_list); i++) {
+ *     sum += values[i];
+ * }
+ */
+void* soa_payloads(soalist* list) {
+    if (!list || list->count == 0) {
+        return NULL;
+    }
+    return list->data;
+}
+
+
+/**
+ * @brief Calls `func` on every payload in storage order.
+ *
+ * Visits each element exactly once by sweeping the payload array, without following links.
+ *
+ * @param list A pointer to the list.
+ * @param func A function that receives a pointer to each payload.
+ * @usage
+ * soa_for_each(my_list, print_double);
+ */
+void soa_for_each(soalist* list, void (*func)(void*)) {
+    if (!list || !func) {
+        return; // Invalid parameters
+    }
+    unsigned char* payload = list->data;
+    for (uint32_t i = 0; i < list->count; i++) {
+        func(payload);
+        payload += list->data_size;
+    }
+}
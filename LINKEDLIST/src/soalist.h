@@ -0,0 +1,198 @@
+#ifndef SOALIST_H
+#define SOALIST_H
+
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+
+
+/**
+ * @brief Sentinel slot index marking the end of a chain.
+ */
+#define SOALIST_NIL UINT32_MAX
+
+
+/**
+ * @brief Singly linked list stored as a struct of arrays.
+ *
+ * Links live in two uint32_t arrays (successor and predecessor) and payloads in a parallel array of
+ * `data_size`-byte slots.
+ * Slots 0 .. count - 1 are always occupied: removing a node moves the last slot into the hole,
+ * so order-independent passes over the payloads (sums, min/max, visits) stream through a single
+ * contiguous array without touching the links. Storage order matches list order only while
+ * elements are appended with soa_insert_end; use the list operations when order matters.
+ */
+typedef struct soalist {
+    uint32_t* next;
+    uint32_t* prev;
+    unsigned char* data;
+    size_t data_size;
+    uint32_t capacity;
+    uint32_t count;
+    uint32_t head;
+    uint32_t tail;
+} soalist;
+
+
+/**
+ * @brief Creates a new struct-of-arrays list.
+ *
+ * @param data_size The size of the data to be stored in each node.
+ * @return A pointer to the newly created list, or NULL if memory allocation fails.
+ *
+ * @usage
+ * soalist* my_list = soalist_create(sizeof(double));
+ * if (my_list == NULL) {
+ *     // Handle memory allocation failure
+ * }
+ */
+soalist* soalist_create(size_t data_size);
+
+
+/**
+ * @brief Inserts a new node at the front of the list.
+ *
+ * @param list A pointer to the list.
+ * @param data A pointer to the data to be stored in the new node.
+ *
+ * @usage
+ * soa_insert_front(my_list, &(double){1.5});
+ */
+void soa_insert_front(soalist* list, void* data);
+
+
+/**
+ * @brief Inserts a new node at the end of the list.
+ *
+ * The list tracks its tail, so this operation does not traverse the list.
+ *
+ * @param list A pointer to the list.
+ * @param data A pointer to the data to be stored in the new node.
+ *
+ * @usage
+ * soa_insert_end(my_list, &(double){1.5});
+ */
+void soa_insert_end(soalist* list, void* data);
+
+
+/**
+ * @brief Inserts a new node at the specified index in the list.
+ *
+ * If the index is 0, the node is inserted at the front. If the index is equal to the length of the list,
+ * the node is inserted at the end. If the index is out of bounds, no insertion is performed.
+ *
+ * @param list A pointer to the list.
+ * @param data A pointer to the data to be stored in the new node.
+ * @param index The position at which to insert the new node (0-based).
+ *
+ * @usage
+ * soa_insert_at_index(my_list, &(double){1.5}, 2);
+ */
+void soa_insert_at_index(soalist* list, void* data, size_t index);
+
+
+/**
+ * @brief Frees the entire list, its arrays and the list structure.
+ *
+ * @param list A pointer to the list to be freed.
+ * @usage
+ * free_soalist(my_list);
+ */
+void free_soalist(soalist* list);
+
+
+/**
+ * @brief Removes the node at the front of the list.
+ *
+ * Keeping the payload array dense may relocate the last stored slot, which takes constant time.
+ *
+ * @param list A pointer to the list.
+ * @usage
+ * soa_free_at_front(my_list);
+ */
+void soa_free_at_front(soalist* list);
+
+
+/**
+ * @brief Removes the node at the end of the list.
+ *
+ * The list keeps back links, so this operation does not traverse the list.
+ *
+ * @param list A pointer to the list.
+ * @usage
+ * soa_free_at_end(my_list);
+ */
+void soa_free_at_end(soalist* list);
+
+
+/**
+ * @brief Removes the node at the specified index in the list.
+ *
+ * If the index is 0, the front node is removed. If the index is out of bounds, no removal is performed.
+ *
+ * @param list A pointer to the list.
+ * @param index The position of the node to be removed (0-based).
+ *
+ * @usage
+ * soa_free_at_index(my_list, 2);
+ */
+void soa_free_at_index(soalist* list, size_t index);
+
+
+/**
+ * @brief Returns the length of the list.
+ *
+ * @param list A pointer to the list.
+ * @return The number of nodes in the list.
+ *
+ * @usage
+ * size_t length = soa_len(my_list);
+ */
+size_t soa_len(soalist* list);
+
+
+/**
+ * @brief Prints the list in list order.
+ * This function traverses the list and prints each node's data using the provided print function.
+ * @param list A pointer to the list.
+ * @param print_func A function pointer to a function that takes a void pointer and prints the data.
+ * @usage
+ * print_soalist(my_list, print_double);
+ */
+void print_soalist(soalist* list, void (*print_func)(void*));
+
+
+/**
+ * @brief Returns the contiguous payload array.
+ *
+ * The array holds soa_len(list) elements of `data_size` bytes in storage order. It is valid
+ * until the next insertion or removal.
+ *
+ * @param list A pointer to the list.
+ * @return A pointer to the first payload, or NULL if the list is empty.
+ *
+ * @usage
+ * const double* values = soa_payloads(my_list);
+ * double sum = 0;
+ * for (size_t i = 0; i < soa_len(my_list); i++) {
+ *     sum += values[i];
+ * }
+ */
+void* soa_payloads(soalist* list);
+
+
+/**
+ * @brief Calls `func` on every payload in storage order.
+ *
+ * Visits each element exactly once by sweeping the payload array, without following links.
+ *
+ * @param list A pointer to the list.
+ * @param func A function that receives a pointer to each payload.
+ * @usage
+ * soa_for_each(my_list, print_double);
+ */
+void soa_for_each(soalist* list, void (*func)(void*));
+
+
+#endif // SOALIST_H
@@ -0,0 +1,143 @@
+#define _POSIX_C_SOURCE 200809L // For mkdtemp
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include "journal.h"
+
+
+// Unlike assert(), never compiled out: every check here also performs the step it checks.
+#define CHECK(cond)                                                                  \
+    do {                                                                             \
+        if (!(cond)) {                                                               \
+            fprintf(stderr, "%s:%d: check failed: %s\n", __FILE__, __LINE__, #cond); \
+            exit(1);                                                                 \
+        }                                                                            \
+    } while (0)
+
+
+static char snapshot_path[64];
+static char log_path[64];
+
+
+/**
+ * @brief Returns the size of a file, or -1 if it does not exist.
+ */
+static long file_size(const char* path) {
+    struct stat st;
+    return stat(path, &st) == 0 ? (long)st.st_size : -1;
+}
+
+
+/**
+ * @brief Builds a journal holding 0 .. 14: ten elements in a checkpointed snapshot, five more only in the log.
+ */
+static void build_journal(void) {
+    unlink(snapshot_path);
+    unlink(log_path);
+    sll_journal* journal = sll_journal_open(snapshot_path, log_path, sizeof(int));
+    CHECK(journal != NULL);
+    for (int i = 0; i < 15; i++) {
+        CHECK(sll_journal_insert_at_index(journal, &i, (size_t)i) == 0);
+        if (i == 9) {
+            CHECK(sll_journal_checkpoint(journal) == 0);
+        }
+    }
+    CHECK(sll_journal_close(journal) == 0);
+}
+
+
+/**
+ * @brief Checks that the journal reopens with all 15 elements in order.
+ */
+static void check_journal(void) {
+    sll_journal* journal = sll_journal_open(snapshot_path, log_path, sizeof(int));
+    CHECK(journal != NULL);
+    CHECK(sll_journal_len(journal) == 15);
+    int expected = 0;
+    sllist_iter it = sllist_iter_begin(journal->list, SLLIST_PREFETCH_DISTANCE);
+    for (int* value; (value = sllist_iter_get(&it)) != NULL; sllist_iter_next(&it)) {
+        CHECK(*value == expected++);
+    }
+    CHECK(sll_journal_close(journal) == 0);
+}
+
+
+/**
+ * @brief A missing snapshot with a log from a later generation must fail the open and leave the log intact.
+ */
+static void test_missing_snapshot(void) {
+    build_journal();
+    char saved[80];
+    snprintf(saved, sizeof(saved), "%s.saved", snapshot_path);
+    CHECK(rename(snapshot_path, saved) == 0);
+    long log_before = file_size(log_path);
+
+    CHECK(sll_journal_open(snapshot_path, log_path, sizeof(int)) == NULL);
+    CHECK(file_size(log_path) == log_before);
+
+    CHECK(rename(saved, snapshot_path) == 0);
+    check_journal();
+}
+
+
+/**
+ * @brief An unreadable snapshot must fail the open and leave the log intact.
+ */
+static void test_unreadable_snapshot(void) {
+    if (geteuid() == 0) {
+        printf("skipped unreadable snapshot test (permissions do not apply to root)\n");
+        return;
+    }
+    build_journal();
+    long log_before = file_size(log_path);
+    CHECK(chmod(snapshot_path, 0) == 0);
+
+    CHECK(sll_journal_open(snapshot_path, log_path, sizeof(int)) == NULL);
+    CHECK(file_size(log_path) == log_before);
+
+    CHECK(chmod(snapshot_path, 0644) == 0);
+    check_journal();
+}
+
+
+/**
+ * @brief A log left behind by a checkpoint that crashed before resetting it is stale and discarded.
+ */
+static void test_stale_log(void) {
+    build_journal();
+    sll_journal* journal = sll_journal_open(snapshot_path, log_path, sizeof(int));
+    CHECK(journal != NULL);
+    FILE* old_log = fopen(log_path, "rb");
+    CHECK(old_log != NULL);
+    char buffer[4096];
+    size_t old_size = fread(buffer, 1, sizeof(buffer), old_log);
+    fclose(old_log);
+    CHECK(sll_journal_checkpoint(journal) == 0);
+    CHECK(sll_journal_close(journal) == 0);
+
+    // Put back the pre-checkpoint log: its records are already in the new snapshot.
+    FILE* log = fopen(log_path, "wb");
+    CHECK(log != NULL && fwrite(buffer, 1, old_size, log) == old_size);
+    fclose(log);
+    check_journal();
+}
+
+
+int main(void) {
+    char dir[] = "/tmp/sll_journal_XXXXXX";
+    CHECK(mkdtemp(dir) != NULL);
+    snprintf(snapshot_path, sizeof(snapshot_path), "%s/list.snap", dir);
+    snprintf(log_path, sizeof(log_path), "%s/list.log", dir);
+
+    test_missing_snapshot();
+    test_unreadable_snapshot();
+    test_stale_log();
+
+    unlink(snapshot_path);
+    unlink(log_path);
+    rmdir(dir);
+    printf("journal recovery tests passed\n");
+    return 0;
+}
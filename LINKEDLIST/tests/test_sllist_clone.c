@@ -0,0 +1,153 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "linkedlist.h"
+
+
+// Unlike assert(), never compiled out.
+#define CHECK(cond)                                                                  \
+    do {                                                                             \
+        if (!(cond)) {                                                               \
+            fprintf(stderr, "%s:%d: check failed: %s\n", __FILE__, __LINE__, #cond); \
+            exit(1);                                                                 \
+        }                                                                            \
+    } while (0)
+
+#define LENGTH 9
+#define MAX_DATA_SIZE 48
+
+
+enum clone_op { INSERT_FRONT, INSERT_MIDDLE, INSERT_END, FREE_FRONT, FREE_MIDDLE, FREE_END, OP_COUNT };
+
+
+/**
+ * @brief The expected contents of a list: element values in order.
+ */
+struct model {
+    int values[LENGTH + 2];
+    size_t len;
+};
+
+
+/**
+ * @brief Builds a list holding 0 .. LENGTH - 1, compacted into one block if `compact` is set.
+ *
+ * Each element is `data_size` bytes with its value in the first int, so sizes above sizeof(void*)
+ * store the data out of line and the clone shares it along with the nodes.
+ */
+static sllist* build_list(size_t data_size, int compact, struct model* model) {
+    sllist* list = sllist_create(data_size);
+    CHECK(list != NULL);
+    unsigned char element[MAX_DATA_SIZE] = {0};
+    for (int i = 0; i < LENGTH; i++) {
+        memcpy(element, &i, sizeof(i));
+        insert_end(list, element);
+        model->values[i] = i;
+    }
+    model->len = LENGTH;
+    if (compact) {
+        sllist_compact(list);
+    }
+    return list;
+}
+
+
+/**
+ * @brief Applies `op` to both the list and its model, inserting `value` for the insert operations.
+ */
+static void apply(sllist* list, struct model* model, enum clone_op op, int value) {
+    unsigned char element[MAX_DATA_SIZE] = {0};
+    memcpy(element, &value, sizeof(value));
+    size_t middle = model->len / 2;
+    size_t index;
+    switch (op) {
+        case INSERT_FRONT:  insert_front(list, element);                  index = 0;              break;
+        case INSERT_MIDDLE: insert_at_index(list, element, middle);       index = middle;         break;
+        case INSERT_END:    insert_end(list, element);                    index = model->len;     break;
+        case FREE_FRONT:    free_at_front(list);                          index = 0;              break;
+        case FREE_MIDDLE:   free_at_index(list, middle);                  index = middle;         break;
+        default:            free_at_end(list);                            index = model->len - 1; break;
+    }
+
+    if (op <= INSERT_END) {
+        memmove(&model->values[index + 1], &model->values[index], (model->len - index) * sizeof(int));
+        model->values[index] = value;
+        model->len++;
+    } else {
+        memmove(&model->values[index], &model->values[index + 1], (model->len - index - 1) * sizeof(int));
+        model->len--;
+    }
+}
+
+
+/**
+ * @brief Checks that the list holds exactly the values of its model, in order.
+ */
+static void check_list(sllist* list, const struct model* model) {
+    CHECK(sll_len(list) == model->len);
+    size_t i = 0;
+    sllist_iter it = sllist_iter_begin(list, SLLIST_PREFETCH_DISTANCE);
+    for (void* data; (data = sllist_iter_get(&it)) != NULL; sllist_iter_next(&it)) {
+        int value;
+        memcpy(&value, data, sizeof(value));
+        CHECK(i < model->len && value == model->values[i]);
+        i++;
+    }
+    CHECK(i == model->len);
+}
+
+
+/**
+ * @brief Clones a list, modifies one side with `op`, then the other with a different operation.
+ *
+ * After the first modification the untouched side must still hold the original elements; after the
+ * second each side must hold only its own change. The two lists are freed in the order given.
+ */
+static void test_clone(size_t data_size, int compact, enum clone_op op, int clone_first, int free_clone_first) {
+    struct model original_model;
+    sllist* original = build_list(data_size, compact, &original_model);
+    sllist* clone = sllist_clone(original);
+    CHECK(clone != NULL);
+    struct model clone_model = original_model;
+
+    sllist* first = clone_first ? clone : original;
+    sllist* second = clone_first ? original : clone;
+    struct model* first_model = clone_first ? &clone_model : &original_model;
+    struct model* second_model = clone_first ? &original_model : &clone_model;
+
+    apply(first, first_model, op, 100);
+    check_list(first, first_model);
+    check_list(second, second_model);
+
+    apply(second, second_model, (enum clone_op)((op + OP_COUNT / 2) % OP_COUNT), 200);
+    check_list(first, first_model);
+    check_list(second, second_model);
+
+    if (free_clone_first) {
+        free_sllist(clone);
+        check_list(original, &original_model);
+        free_sllist(original);
+    } else {
+        free_sllist(original);
+        check_list(clone, &clone_model);
+        free_sllist(clone);
+    }
+}
+
+
+int main(void) {
+    const size_t data_sizes[] = { sizeof(int), MAX_DATA_SIZE }; // Inline and out-of-line data
+    for (size_t s = 0; s < sizeof(data_sizes) / sizeof(data_sizes[0]); s++) {
+        for (int compact = 0; compact <= 1; compact++) {
+            for (int op = 0; op < OP_COUNT; op++) {
+                for (int clone_first = 0; clone_first <= 1; clone_first++) {
+                    for (int free_clone_first = 0; free_clone_first <= 1; free_clone_first++) {
+                        test_clone(data_sizes[s], compact, (enum clone_op)op, clone_first, free_clone_first);
+                    }
+                }
+            }
+        }
+    }
+    printf("clone tests passed\n");
+    return 0;
+}